@@ -0,0 +1,320 @@
+/*
+  ==============================================================================
+
+    BiquadEngine.h
+    Created: 16 Oct 2026 10:12:31am
+    Author:  brccabral
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginUtilities.h"
+#include "FrequencyTable.h"
+#include "ChainEngine.h"
+
+inline BiquadCoeffs interpolate(const BiquadCoeffs &a, const BiquadCoeffs &b, double t) noexcept
+{
+    return {interpolate(a.b0, b.b0, t), interpolate(a.b1, b.b1, t), interpolate(a.b2, b.b2, t), interpolate(a.a1, b.a1, t), interpolate(a.a2, b.a2, t)};
+}
+
+// * a section between identity, weight 0, and the coefficients, weight 1
+// * the stable region is convex and identity is in it, so every point on the way is stable
+inline BiquadCoeffs fadeFromIdentity(const BiquadCoeffs &coefficients, double weight) noexcept
+{
+    if (weight == 1.0)
+        return coefficients;
+
+    return {1.0 + weight * (coefficients.b0 - 1.0), weight * coefficients.b1, weight * coefficients.b2, weight * coefficients.a1, weight * coefficients.a2};
+}
+
+// * one biquad per lane
+template <typename SampleType>
+struct BiquadLanes
+{
+    using Vec = juce::dsp::SIMDRegister<SampleType>;
+
+    Vec b0, b1, b2, a1, a2;
+};
+
+/*
+ Runs the whole LowCut -> peak bank -> HighCut chain for several channels at once.
+ Each channel lives in one lane of a juce::dsp::SIMDRegister, so a stereo signal is filtered
+ by one pass over the buffer instead of one pass per channel and per stage.
+ The sections are the same transposed direct form II biquads as juce::dsp::IIR::Filter.
+
+ The active sections are packed in processing order and the per-sample loop is a template on
+ their count, so the compiler unrolls the cascade and keeps every section state in registers.
+ Chains longer than MaxUnrolledSections share one looped kernel, see LaneChainEngine.
+ The count is picked once per block from the slopes and bypass flags, so the bands of the bank that
+ are switched off or flat cost nothing and the rest run in the same fused loop as the cuts.
+
+ New coefficients are not applied as a step: the chain glides from the coefficients it is
+ using to the new ones, updating them every controlInterval samples, see ChainEngine. The glide
+ is a straight line in the (b0, b1, b2, a1, a2) space. The stable region of a biquad denominator
+ is the triangle |a2| < 1, |a1| < 1 + a2, which is convex, so every point on the way is stable too.
+ Sections switching on or off fade from or to identity, which also makes bypass click free.
+
+ The chain doesn't follow the LFO. A direct form section whose coefficients move every sample
+ overshoots, so the plugin runs modulated chains as state variable filters, see
+ makeChainCoefficients().
+
+ A channel alone in its group (mono, or the last of an odd count) would leave the other lanes
+ idle, so it runs in blocks of Lanes samples instead, the lanes being time. Over a block each
+ section is a state space step: the outputs are the impulse response applied to the block
+ inputs plus the response to the two states, Lanes + 2 vector multiply-adds, and the states
+ after the block come from its last two inputs and outputs. The sections run as a wavefront
+ over the blocks, so a block doesn't wait for the previous one to leave the whole cascade.
+ The matrices are rebuilt in pack(), so only when the coefficients change. The state is the same
+ as the lane kernel's, so the two can take over from each other at any sample. Double stays on
+ the lane kernel: two samples per block don't pay for the matrices.
+
+ A stereo pair is one group, lane 0 mid and lane 1 side, the encode and decode are part of the lane
+ gather and scatter. A band fades to identity on the lane it doesn't reach, see LaneChainEngine.
+ */
+template <typename SampleType>
+class MultiChannelChain : public LaneChainEngine<MultiChannelChain<SampleType>, SampleType, BiquadLanes<SampleType>, BiquadCoeffs>
+{
+    using Base = LaneChainEngine<MultiChannelChain<SampleType>, SampleType, BiquadLanes<SampleType>, BiquadCoeffs>;
+    friend Base;
+
+    using typename Base::GroupState;
+    using typename Base::Vec;
+    using Base::Lanes;
+    using Base::MaxUnrolledSections;
+    using Base::LoopedSections;
+    using Section = BiquadLanes<SampleType>;
+
+    static constexpr bool FollowsLfo = false;
+
+    // * a section stepped over a block of Lanes samples of one channel, lane j of a vector is sample j
+    // * impulse[k] is the response to the input sample k, fromS1 and fromS2 the response to the states
+    struct BlockSection
+    {
+        std::array<Vec, (size_t)Lanes> impulse;
+        Vec fromS1, fromS2;
+        SampleType b0, b1, b2, a1, a2;
+    };
+
+    // * runs a channel alone in its group through the packed sections, a block of Lanes samples at a time
+    using BlockKernel = void (MultiChannelChain::*)(GroupState &, const SampleType *, SampleType *, int) noexcept;
+
+    static_assert(Lanes >= 2, "the states after a block come from its last two samples");
+
+    static constexpr bool hasBlockKernel = Lanes >= 4;
+
+    // * the packed sections again, for the block kernel
+    std::array<BlockSection, NumChainSlots> blockSections;
+
+    void setSlotTargets(const ChainCoefficients &chainCoefficients) noexcept
+    {
+        auto &targets = this->targetParameters;
+
+        for (int i = 0; i < MaxCutSections; ++i)
+        {
+            targets[(size_t)(LowCutSlot + i)] = chainCoefficients.lowCut[(size_t)i];
+            targets[(size_t)(HighCutSlot + i)] = chainCoefficients.highCut[(size_t)i];
+        }
+
+        for (int band = 0; band < MaxPeakBands; ++band)
+            targets[(size_t)(PeakSlot + band)] = chainCoefficients.peaks[(size_t)band];
+    }
+
+    void setSection(int n, const BiquadCoeffs &slot, double weight, int band, int) noexcept
+    {
+        const auto coefficients = fadeFromIdentity(slot, weight);
+
+        loadSection(this->sections[(size_t)n], coefficients, band);
+        setBlockSection(blockSections[(size_t)n], coefficients);
+    }
+
+    // * transposed direct form II, s1 and s2 are the two delayed partial sums
+    static Vec processSection(const Section &c, Vec &s1, Vec &s2, Vec x) noexcept
+    {
+        auto y = c.b0 * x + s1;
+        s1 = c.b1 * x - c.a1 * y + s2;
+        s2 = c.b2 * x - c.a2 * y;
+        return y;
+    }
+
+    // * every lane gets the coefficients, in mid/side faded to identity by how much the band reaches the lane
+    void loadSection(Section &section, const BiquadCoeffs &coefficients, int band) const noexcept
+    {
+        if (!this->midSide)
+        {
+            section.b0 = Vec::expand((SampleType)coefficients.b0);
+            section.b1 = Vec::expand((SampleType)coefficients.b1);
+            section.b2 = Vec::expand((SampleType)coefficients.b2);
+            section.a1 = Vec::expand((SampleType)coefficients.a1);
+            section.a2 = Vec::expand((SampleType)coefficients.a2);
+            return;
+        }
+
+        alignas(Vec) SampleType b0[Lanes], b1[Lanes], b2[Lanes], a1[Lanes], a2[Lanes];
+
+        for (size_t l = 0; l < (size_t)Lanes; ++l)
+        {
+            const auto lane = fadeFromIdentity(coefficients, this->getLaneWeight(band, l));
+
+            b0[l] = (SampleType)lane.b0;
+            b1[l] = (SampleType)lane.b1;
+            b2[l] = (SampleType)lane.b2;
+            a1[l] = (SampleType)lane.a1;
+            a2[l] = (SampleType)lane.a2;
+        }
+
+        section.b0 = Vec::fromRawArray(b0);
+        section.b1 = Vec::fromRawArray(b1);
+        section.b2 = Vec::fromRawArray(b2);
+        section.a1 = Vec::fromRawArray(a1);
+        section.a2 = Vec::fromRawArray(a2);
+    }
+
+    // * runs the section recursion in double from a unit input or a unit state, Lanes samples each
+    static void setBlockSection(BlockSection &section, const BiquadCoeffs &coefficients) noexcept
+    {
+        alignas(Vec) SampleType response[Lanes];
+
+        auto run = [&](int impulseAt, double s1, double s2)
+        {
+            for (int j = 0; j < Lanes; ++j)
+            {
+                const auto x = j == impulseAt ? 1.0 : 0.0;
+                const auto y = coefficients.b0 * x + s1;
+
+                s1 = coefficients.b1 * x - coefficients.a1 * y + s2;
+                s2 = coefficients.b2 * x - coefficients.a2 * y;
+
+                response[j] = (SampleType)y;
+            }
+
+            return Vec::fromRawArray(response);
+        };
+
+        for (int k = 0; k < Lanes; ++k)
+            section.impulse[(size_t)k] = run(k, 0.0, 0.0);
+
+        section.fromS1 = run(-1, 1.0, 0.0);
+        section.fromS2 = run(-1, 0.0, 1.0);
+
+        section.b0 = (SampleType)coefficients.b0;
+        section.b1 = (SampleType)coefficients.b1;
+        section.b2 = (SampleType)coefficients.b2;
+        section.a1 = (SampleType)coefficients.a1;
+        section.a2 = (SampleType)coefficients.a2;
+    }
+
+    bool processAlone(GroupState &state, const SampleType *input, SampleType *output, int numSamples) noexcept
+    {
+        if (!hasBlockKernel)
+            return false;
+
+        (this->*getBlockKernel(this->numActive))(state, input, output, numSamples);
+        return true;
+    }
+
+    // * like the lane kernels, one per section count up to MaxUnrolledSections, then the looped one
+    template <size_t... NumSections>
+    static constexpr auto makeBlockKernelTable(std::index_sequence<NumSections...>) noexcept
+    {
+        return std::array<BlockKernel, sizeof...(NumSections) + 1>{{&MultiChannelChain::processChannelBlocks<(int)NumSections>...,
+                                                                    &MultiChannelChain::processChannelBlocks<LoopedSections>}};
+    }
+
+    static BlockKernel getBlockKernel(int numSections) noexcept
+    {
+        static constexpr auto kernels = makeBlockKernelTable(std::make_index_sequence<MaxUnrolledSections + 1>{});
+        return kernels[(size_t)juce::jmin(numSections, MaxUnrolledSections + 1)];
+    }
+
+    template <int NumSections>
+    void processChannelBlocks(GroupState &state, const SampleType *input, SampleType *output, int numSamples) noexcept
+    {
+        constexpr auto capacity = Base::template KernelCapacity<NumSections>;
+        const auto numSections = (int)this->template getKernelSections<NumSections>();
+
+        // * the channel is lane 0 of the group state
+        std::array<SampleType, capacity> s1, s2;
+
+        for (size_t n = 0; n < (size_t)numSections; ++n)
+        {
+            const auto slot = (size_t)this->activeSlots[n];
+
+            s1[n] = state.s1[slot].get(0);
+            s2[n] = state.s2[slot].get(0);
+        }
+
+        // * blocks[n] is what section n works on: the block that section n - 1 finished one step earlier
+        alignas(Vec) SampleType blocks[capacity + 1][Lanes];
+
+        auto runSection = [&](size_t n)
+        {
+            const auto &c = blockSections[n];
+            auto *block = blocks[n];
+
+            auto y = c.fromS1 * Vec::expand(s1[n]) + c.fromS2 * Vec::expand(s2[n]);
+
+            for (size_t k = 0; k < (size_t)Lanes; ++k)
+                y += c.impulse[k] * Vec::expand(block[k]);
+
+            const auto x1 = block[Lanes - 1], x2 = block[Lanes - 2];
+            y.copyToRawArray(blocks[n + 1]);
+            const auto y1 = blocks[n + 1][Lanes - 1], y2 = blocks[n + 1][Lanes - 2];
+
+            // * one and two steps of the recursion back from the end of the block
+            s2[n] = c.b2 * x1 - c.a2 * y1;
+            s1[n] = c.b1 * x1 - c.a1 * y1 + c.b2 * x2 - c.a2 * y2;
+        };
+
+        // * a wavefront: at step t section n works on block t - n, so the sections of one step don't wait
+        // * on each other and the cascade latency is paid once per call instead of once per block
+        const auto numBlocks = numSamples / Lanes;
+
+        for (int t = 0; t < numBlocks + numSections - 1; ++t)
+        {
+            // * the sections that have a block at this step, all of them once the wavefront is full
+            const auto first = juce::jmax(0, t - numBlocks + 1);
+            const auto last = juce::jmin(numSections - 1, t);
+
+            if (first == 0)
+                for (int j = 0; j < Lanes; ++j)
+                    blocks[0][j] = input[t * Lanes + j];
+
+            // * from the last section down, each one reads its block before the one before it overwrites it
+            for (int n = last; n >= first; --n)
+                runSection((size_t)n);
+
+            if (numSections > 0 && last == numSections - 1)
+                for (int j = 0; j < Lanes; ++j)
+                    output[(t - last) * Lanes + j] = blocks[numSections][j];
+        }
+
+        // * what is left of the block, one sample at a time
+        for (int i = numBlocks * Lanes; i < numSamples; ++i)
+        {
+            auto x = input[i];
+
+            for (size_t n = 0; n < (size_t)numSections; ++n)
+            {
+                const auto &c = blockSections[n];
+
+                const auto y = c.b0 * x + s1[n];
+                s1[n] = c.b1 * x - c.a1 * y + s2[n];
+                s2[n] = c.b2 * x - c.a2 * y;
+                x = y;
+            }
+
+            output[i] = x;
+        }
+
+        for (size_t n = 0; n < (size_t)numSections; ++n)
+        {
+            const auto slot = (size_t)this->activeSlots[n];
+
+            state.s1[slot].set(0, s1[n]);
+            state.s2[slot].set(0, s2[n]);
+        }
+    }
+};
@@ -0,0 +1,649 @@
+/*
+  ==============================================================================
+
+    ChainEngine.h
+    Created: 17 Oct 2026 12:24:06am
+    Author:  brccabral
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginUtilities.h"
+#include "FrequencyTable.h"
+
+// * every section of the chain has a fixed slot, its position in processing order: LowCut stages,
+// * peak bands, HighCut stages
+// * the slot keeps its filter state even while the section is switched off, so it can come back without a click
+static constexpr int LowCutSlot = LowCutPosition;
+static constexpr int PeakSlot = PeakPosition;
+static constexpr int HighCutSlot = HighCutPosition;
+static constexpr int NumChainSlots = MaxChainSections;
+
+// * the slots a chain runs, the same for every structure
+inline std::array<bool, NumChainSlots> getActiveSlots(const ChainCoefficients &chainCoefficients) noexcept
+{
+    std::array<bool, NumChainSlots> activeSlots{};
+
+    forEachActiveSection(chainCoefficients, [&activeSlots](const BiquadCoeffs &, int position)
+                         { activeSlots[(size_t)position] = true; });
+
+    return activeSlots;
+}
+
+// * the band a slot belongs to, indexed like ChainPositions
+inline int getSlotBand(size_t slot) noexcept
+{
+    if (slot < (size_t)PeakSlot)
+        return LowCut;
+
+    return slot < (size_t)HighCutSlot ? Peak : HighCut;
+}
+
+// * the glides are straight lines in whatever a slot or the chain is set by
+inline double interpolate(double a, double b, double t) noexcept
+{
+    return a + t * (b - a);
+}
+
+// * the rate isn't glided, the LFO only changes speed
+inline FrequencyModulation interpolate(const FrequencyModulation &a, const FrequencyModulation &b, double t) noexcept
+{
+    auto modulation = b;
+
+    for (size_t band = 0; band < 3; ++band)
+    {
+        modulation.positions[band] = interpolate(a.positions[band], b.positions[band], t);
+        modulation.depths[band] = interpolate(a.depths[band], b.depths[band], t);
+    }
+
+    return modulation;
+}
+
+// * what a lane chain glides as a whole: the LFO, and how much each band filters mid and side
+// * reach is indexed by ChainPositions and lane, 1 where the band filters and 0 where it passes through
+struct LaneChainParameters
+{
+    FrequencyModulation modulation;
+    std::array<std::array<double, 2>, 3> reach{{{1.0, 1.0}, {1.0, 1.0}, {1.0, 1.0}}};
+};
+
+inline LaneChainParameters interpolate(const LaneChainParameters &a, const LaneChainParameters &b, double t) noexcept
+{
+    auto parameters = b;
+
+    parameters.modulation = interpolate(a.modulation, b.modulation, t);
+
+    for (size_t band = 0; band < 3; ++band)
+        for (size_t l = 0; l < 2; ++l)
+            parameters.reach[band][l] = interpolate(a.reach[band][l], b.reach[band][l], t);
+
+    return parameters;
+}
+
+// * the kernels move one sample of every channel in and out of the lanes, in mid/side the first two
+// * channels are encoded to mid and side on the way in and decoded on the way out, in the same pass
+template <bool MidSide, typename SampleType, size_t Lanes>
+inline void gatherLanes(SampleType (&lanes)[Lanes], const SampleType *const *inputs, int i) noexcept
+{
+    for (size_t l = 0; l < Lanes; ++l)
+        lanes[l] = inputs[l][i];
+
+    if constexpr (MidSide)
+    {
+        const auto left = lanes[0], right = lanes[1];
+
+        lanes[0] = (left + right) * SampleType(0.5);
+        lanes[1] = (left - right) * SampleType(0.5);
+    }
+}
+
+template <bool MidSide, typename SampleType, size_t Lanes>
+inline void scatterLanes(const SampleType (&lanes)[Lanes], SampleType *const *outputs, int i) noexcept
+{
+    size_t l = 0;
+
+    if constexpr (MidSide)
+    {
+        outputs[0][i] = lanes[0] + lanes[1];
+        outputs[1][i] = lanes[0] - lanes[1];
+        l = 2;
+    }
+
+    for (; l < Lanes; ++l)
+        outputs[l][i] = lanes[l];
+}
+
+/*
+ What the chain engines share, whatever their sections are: the slots, the glide from the
+ parameters in use to new ones, the sections joining and leaving the chain, the control ticks and
+ the block splitting. Derived is the engine, it supplies:
+
+   setTargets(chainCoefficients)                 fills targetParameters and targetChain from a design
+   prepareState(), clearState(), clearState(slot) sizes and silences the filter state
+   pack()                                        turns the current parameters into what the kernel reads
+   isPassThrough()                               true when the packed chain leaves the signal as is
+   processSamples(input, output, channels, numSamples)
+
+ SlotParameters is what one slot is set by and ChainParameters what the whole chain is set by, both
+ glide on a straight line, see interpolate(). Every slot also has a weight, 1 while it is in the
+ chain and 0 for a pass through, the engine mixes it into the section it packs. A slot joining the
+ chain starts at its target with a weight of 0 and a clean state, a slot leaving it keeps its
+ parameters while its weight goes to 0, so neither clicks.
+ */
+template <typename Derived, typename SlotParameters, typename ChainParameters>
+class ChainEngine
+{
+public:
+    void prepare(const juce::dsp::ProcessSpec &spec)
+    {
+        numChannels = (int)spec.numChannels;
+        maxBlockSize = (int)spec.maximumBlockSize;
+        sampleRate = spec.sampleRate;
+
+        glide.reset(sampleRate, glideTimeSeconds);
+
+        derived().prepareState();
+        derived().reset();
+    }
+
+    // * clears the filter state, the next setCoefficients() is applied right away
+    void reset() noexcept
+    {
+        derived().clearState();
+        jumpToNextCoefficients = true;
+    }
+
+    // * for running at another rate than the one prepared for (oversampling), safe on the audio thread
+    void setSampleRate(double newSampleRate) noexcept
+    {
+        sampleRate = newSampleRate;
+        glide.reset(sampleRate, glideTimeSeconds);
+    }
+
+    // * how often the parameters are updated while gliding, in samples
+    void setControlInterval(int numSamples) noexcept
+    {
+        jassert(numSamples > 0);
+        controlInterval = numSamples;
+    }
+
+    // * how long it takes to reach new parameters
+    void setGlideTime(double seconds) noexcept
+    {
+        glideTimeSeconds = seconds;
+        glide.reset(sampleRate, glideTimeSeconds);
+    }
+
+    // * called from the audio thread, only copies values
+    void setCoefficients(const ChainCoefficients &chainCoefficients) noexcept
+    {
+        const auto newActive = getActiveSlots(chainCoefficients);
+
+        derived().setTargets(chainCoefficients);
+
+        if (jumpToNextCoefficients || glideTimeSeconds <= 0)
+        {
+            jumpToNextCoefficients = false;
+
+            currentParameters = targetParameters;
+            currentChain = targetChain;
+            active = targetActive = newActive;
+
+            for (size_t slot = 0; slot < NumChainSlots; ++slot)
+                currentWeight[slot] = active[slot] ? 1.0 : 0.0;
+
+            glide.setCurrentAndTargetValue(1.f);
+            derived().pack();
+            return;
+        }
+
+        for (size_t slot = 0; slot < NumChainSlots; ++slot)
+        {
+            // * a section joining the chain starts as a pass through with a clean state
+            if (newActive[slot] && !active[slot])
+            {
+                currentParameters[slot] = targetParameters[slot];
+                currentWeight[slot] = 0.0;
+                derived().clearState(slot);
+            }
+
+            // * a section leaving it stays as it is while it fades out
+            if (!newActive[slot] && active[slot])
+                targetParameters[slot] = currentParameters[slot];
+
+            active[slot] = active[slot] || newActive[slot];
+        }
+
+        // * glide from wherever we are now, even if an older glide hasn't finished
+        startParameters = currentParameters;
+        startWeight = currentWeight;
+        startChain = currentChain;
+        targetActive = newActive;
+
+        glide.setCurrentAndTargetValue(0.f);
+        glide.setTargetValue(1.f);
+        samplesUntilControlTick = 0;
+    }
+
+    bool isGliding() const noexcept { return glide.isSmoothing(); }
+
+    template <typename ProcessContext>
+    void process(const ProcessContext &context) noexcept
+    {
+        const auto &inputBlock = context.getInputBlock();
+        auto &outputBlock = context.getOutputBlock();
+
+        const auto numSamples = (int)outputBlock.getNumSamples();
+        const auto channels = juce::jmin(numChannels, (int)outputBlock.getNumChannels());
+
+        jassert(numSamples <= maxBlockSize);
+        jassert(inputBlock.getNumChannels() == outputBlock.getNumChannels());
+
+        if (context.isBypassed)
+        {
+            if (context.usesSeparateInputAndOutputBlocks())
+                outputBlock.copyFrom(inputBlock);
+
+            return;
+        }
+
+        const auto separateBlocks = context.usesSeparateInputAndOutputBlocks();
+
+        // * steady state: one kernel call for the whole block
+        if (!glide.isSmoothing())
+        {
+            processRange(inputBlock, outputBlock, separateBlocks, channels, 0, numSamples);
+            return;
+        }
+
+        // * gliding: split the block at control ticks, the interval carries over between blocks
+        for (int start = 0; start < numSamples;)
+        {
+            if (samplesUntilControlTick == 0)
+            {
+                controlTick();
+                samplesUntilControlTick = controlInterval;
+            }
+
+            auto length = juce::jmin(samplesUntilControlTick, numSamples - start);
+
+            processRange(inputBlock, outputBlock, separateBlocks, channels, start, length);
+
+            start += length;
+            samplesUntilControlTick -= length;
+        }
+    }
+
+protected:
+    // * per slot: what is running now, where the glide started and where it goes
+    std::array<SlotParameters, NumChainSlots> currentParameters{}, startParameters{}, targetParameters{};
+    std::array<double, NumChainSlots> currentWeight{}, startWeight{};
+    std::array<bool, NumChainSlots> active{}, targetActive{};
+
+    ChainParameters currentChain{}, startChain{}, targetChain{};
+
+    juce::SmoothedValue<float, juce::ValueSmoothingTypes::Linear> glide{1.f};
+    double glideTimeSeconds = 0.05;
+    int controlInterval = 32;
+    int samplesUntilControlTick = 0;
+    bool jumpToNextCoefficients = true;
+
+    int numChannels = 0, maxBlockSize = 0;
+    double sampleRate = 44100.0;
+
+private:
+    Derived &derived() noexcept { return static_cast<Derived &>(*this); }
+
+    void controlTick() noexcept
+    {
+        const auto t = (double)glide.skip(controlInterval);
+
+        for (size_t slot = 0; slot < NumChainSlots; ++slot)
+        {
+            if (!active[slot])
+                continue;
+
+            currentParameters[slot] = interpolate(startParameters[slot], targetParameters[slot], t);
+            currentWeight[slot] = interpolate(startWeight[slot], targetActive[slot] ? 1.0 : 0.0, t);
+        }
+
+        currentChain = interpolate(startChain, targetChain, t);
+
+        // * arrived: the sections that faded out leave the chain
+        if (!glide.isSmoothing())
+        {
+            currentParameters = targetParameters;
+            currentChain = targetChain;
+            active = targetActive;
+
+            for (size_t slot = 0; slot < NumChainSlots; ++slot)
+                currentWeight[slot] = active[slot] ? 1.0 : 0.0;
+        }
+
+        derived().pack();
+    }
+
+    template <typename InputBlock, typename OutputBlock>
+    void processRange(const InputBlock &inputBlock,
+                      const OutputBlock &outputBlock,
+                      bool separateBlocks,
+                      int channels,
+                      int start,
+                      int length) noexcept
+    {
+        if (derived().isPassThrough())
+        {
+            if (separateBlocks)
+                outputBlock.getSubBlock((size_t)start, (size_t)length).copyFrom(inputBlock.getSubBlock((size_t)start, (size_t)length));
+
+            return;
+        }
+
+        derived().processSamples(inputBlock.getSubBlock((size_t)start, (size_t)length),
+                                 outputBlock.getSubBlock((size_t)start, (size_t)length),
+                                 channels,
+                                 length);
+    }
+};
+
+/*
+ The chain engines that run one channel per SIMD lane, a stereo pair being one group of lanes
+ filtered in one pass. On top of ChainEngine this is the LFO, the mid/side placement, the packing of
+ the active sections in processing order and a straight line kernel per section count, up to
+MaxUnrolledSections, with one looped kernel for the longer chains.
+
+ A stereo pair always runs as mid and side. With every band on both lanes that is the same filter
+ as left and right, so the Stereo Mode and the band placement only move the reach of each band,
+ which glides like the weight of a slot: the lanes a band doesn't reach fade to a pass through.
+
+ Derived supplies the section math:
+
+   setSlotTargets(chainCoefficients)             the SlotParameters of every slot
+   setSection(n, parameters, weight, band, modulatedBand) packs the n-th active section, see getLaneWeight()
+   FollowsLfo                                    false for an engine that can't sweep its sections
+   modulateSections(sections, numSections, lfoValue) new loop coefficients for the swept sections, if FollowsLfo
+   processSection(section, s1, s2, x)            one sample through one section, returns its output
+   processAlone(state, input, output, numSamples) optional, for a channel alone in its group
+
+ Section is what processSection() reads, one value per lane. Every section keeps two state values
+ per lane, s1 and s2, what they hold is up to the section.
+ */
+template <typename Derived, typename SampleType, typename Section, typename SlotParameters>
+class LaneChainEngine : public ChainEngine<Derived, SlotParameters, LaneChainParameters>
+{
+public:
+    using Vec = juce::dsp::SIMDRegister<SampleType>;
+    static constexpr int Lanes = (int)Vec::size();
+
+    void reset() noexcept
+    {
+        Engine::reset();
+        lfo.reset();
+    }
+
+    void setSampleRate(double newSampleRate) noexcept
+    {
+        Engine::setSampleRate(newSampleRate);
+        lfo.setFrequency(this->targetChain.modulation.rate, this->sampleRate);
+    }
+
+    // * where modulated bands look their frequency up, built for the rate the chain runs at
+    // * without a table the bands stay at their base frequency
+    void setFrequencyTable(const FrequencyTable *newTable) noexcept
+    {
+        jassert(newTable == nullptr || newTable->getSampleRate() == this->sampleRate);
+        frequencyTable = newTable;
+        pack();
+    }
+
+protected:
+    using Engine = ChainEngine<Derived, SlotParameters, LaneChainParameters>;
+    friend Engine;
+
+    struct GroupState
+    {
+        std::array<Vec, NumChainSlots> s1, s2;
+    };
+
+    // * packed in processing order, activeSlots[n] is where sections[n] keeps its state
+    std::array<Section, NumChainSlots> sections;
+    std::array<int, NumChainSlots> activeSlots{};
+    int numActive = 0;
+    int numModulated = 0;
+
+    const FrequencyTable *frequencyTable = nullptr;
+    QuadratureLfo lfo;
+
+    // * a stereo pair is matrixed to mid and side in the lanes
+    bool midSide = false;
+
+    // * the section counts with a straight line kernel of their own, longer chains run the looped one
+    // * past 8 sections the states no longer fit in registers, so unrolling further bought no speed,
+    // * and a kernel for every count up to 32 made the float engines 2.8 times the code and compile time
+    static constexpr int MaxUnrolledSections = 8;
+    static constexpr int LoopedSections = -1;
+
+    // * how many sections a kernel runs, and how many it has room for
+    template <int NumSections>
+    static constexpr size_t KernelCapacity = NumSections == LoopedSections ? (size_t)NumChainSlots : (size_t)NumSections;
+
+    template <int NumSections>
+    size_t getKernelSections() const noexcept
+    {
+        return NumSections == LoopedSections ? (size_t)numActive : (size_t)NumSections;
+    }
+
+    // * how much of the slot weight a band keeps on a lane, lanes past mid and side are other channels
+    double getLaneWeight(int band, size_t lane) const noexcept
+    {
+        return lane < 2 ? this->currentChain.reach[(size_t)band][lane] : 1.0;
+    }
+
+    // * a channel alone in its group has nothing else to run, see processAlone()
+    bool processAlone(GroupState &, const SampleType *, SampleType *, int) noexcept { return false; }
+
+private:
+    // * runs one group of lanes through the packed sections
+    using GroupKernel = void (LaneChainEngine::*)(GroupState &, const SampleType *const *, SampleType *const *, int) noexcept;
+
+    GroupKernel kernel = getKernel(0, false, false);
+
+    std::vector<GroupState> groups;
+    std::vector<SampleType> silence, discard;
+
+    Derived &derived() noexcept { return static_cast<Derived &>(*this); }
+
+    void prepareState()
+    {
+        groups.resize((size_t)((this->numChannels + Lanes - 1) / Lanes));
+
+        // * lanes without a channel read silence and write to a scratch buffer
+        silence.assign((size_t)this->maxBlockSize, SampleType(0));
+        discard.resize((size_t)this->maxBlockSize);
+
+        midSide = this->numChannels == 2;
+
+        lfo.setFrequency(this->targetChain.modulation.rate, this->sampleRate);
+    }
+
+    void clearState() noexcept
+    {
+        for (auto &group : groups)
+        {
+            group.s1.fill(Vec::expand(SampleType(0)));
+            group.s2.fill(Vec::expand(SampleType(0)));
+        }
+    }
+
+    void clearState(size_t slot) noexcept
+    {
+        for (auto &group : groups)
+        {
+            group.s1[slot] = Vec::expand(SampleType(0));
+            group.s2[slot] = Vec::expand(SampleType(0));
+        }
+    }
+
+    void setTargets(const ChainCoefficients &chainCoefficients) noexcept
+    {
+        if (this->targetChain.modulation.rate != chainCoefficients.modulation.rate)
+            lfo.setFrequency(chainCoefficients.modulation.rate, this->sampleRate);
+
+        this->targetChain.modulation = chainCoefficients.modulation;
+
+        // * left/right is every band on both lanes
+        for (size_t band = 0; band < 3; ++band)
+            for (size_t l = 0; l < 2; ++l)
+            {
+                const auto reaches = !chainCoefficients.midSide || doesBandReach(chainCoefficients.bandChannels[band], (int)l);
+                this->targetChain.reach[band][l] = reaches ? 1.0 : 0.0;
+            }
+
+        derived().setSlotTargets(chainCoefficients);
+    }
+
+    void pack() noexcept
+    {
+        numActive = 0;
+        numModulated = 0;
+
+        for (size_t slot = 0; slot < NumChainSlots; ++slot)
+        {
+            if (!this->active[slot])
+                continue;
+
+            const auto band = getSlotBand(slot);
+
+            // * the LFO sweeps the first band of the bank only
+            const auto isSwept = this->currentChain.modulation.depths[(size_t)band] > 0 && (band != Peak || slot == (size_t)PeakSlot);
+            const auto modulatedBand = Derived::FollowsLfo && frequencyTable != nullptr && isSwept ? band : -1;
+
+            numModulated += modulatedBand >= 0 ? 1 : 0;
+
+            derived().setSection(numActive, this->currentParameters[slot], this->currentWeight[slot], band, modulatedBand);
+
+            activeSlots[(size_t)numActive++] = (int)slot;
+        }
+
+        // * the plan only changes here, the blocks in between run the kernel picked now
+        kernel = getKernel(numActive, numModulated > 0, midSide);
+    }
+
+    bool isPassThrough() const noexcept { return numActive == 0; }
+
+    // * with and without modulation, left/right or mid/side
+    // * an engine that doesn't follow the LFO gets its unmodulated kernels in the modulated entries
+    template <int NumSections>
+    static constexpr std::array<GroupKernel, 4> makeKernelRow() noexcept
+    {
+        constexpr auto modulated = Derived::FollowsLfo;
+
+        return {&LaneChainEngine::processGroup<NumSections, false, false>,
+                &LaneChainEngine::processGroup<NumSections, modulated, false>,
+                &LaneChainEngine::processGroup<NumSections, false, true>,
+                &LaneChainEngine::processGroup<NumSections, modulated, true>};
+    }
+
+    // * one straight line kernel per active section count up to MaxUnrolledSections, then the looped one
+    // * which bands, slopes and bypasses make up the plan only changes the packed coefficients, not the code
+    template <size_t... NumSections>
+    static constexpr auto makeKernelTable(std::index_sequence<NumSections...>) noexcept
+    {
+        return std::array<std::array<GroupKernel, 4>, sizeof...(NumSections) + 1>{{makeKernelRow<(int)NumSections>()...,
+                                                                                    makeKernelRow<LoopedSections>()}};
+    }
+
+    static GroupKernel getKernel(int numSections, bool modulated, bool isMidSide) noexcept
+    {
+        static constexpr auto kernels = makeKernelTable(std::make_index_sequence<MaxUnrolledSections + 1>{});
+        return kernels[(size_t)juce::jmin(numSections, MaxUnrolledSections + 1)][(modulated ? 1 : 0) + (isMidSide ? 2 : 0)];
+    }
+
+    template <typename InputBlock, typename OutputBlock>
+    void processSamples(const InputBlock &inputBlock, const OutputBlock &outputBlock, int channels, int numSamples) noexcept
+    {
+        std::array<const SampleType *, (size_t)Lanes> inputs;
+        std::array<SampleType *, (size_t)Lanes> outputs;
+
+        // * every group follows the same LFO, each one runs it from where the block starts
+        const auto lfoStart = lfo;
+
+        for (int g = 0; g * Lanes < channels; ++g)
+        {
+            if (channels - g * Lanes == 1
+                && derived().processAlone(groups[(size_t)g],
+                                          inputBlock.getChannelPointer((size_t)(g * Lanes)),
+                                          outputBlock.getChannelPointer((size_t)(g * Lanes)),
+                                          numSamples))
+                continue;
+
+            for (int l = 0; l < Lanes; ++l)
+            {
+                auto channel = g * Lanes + l;
+                auto used = channel < channels;
+
+                inputs[(size_t)l] = used ? inputBlock.getChannelPointer((size_t)channel) : silence.data();
+                outputs[(size_t)l] = used ? outputBlock.getChannelPointer((size_t)channel) : discard.data();
+            }
+
+            lfo = lfoStart;
+
+            (this->*kernel)(groups[(size_t)g], inputs.data(), outputs.data(), numSamples);
+        }
+
+        lfo.normalise();
+    }
+
+    template <int NumSections, bool Modulated, bool MidSide>
+    void processGroup(GroupState &state,
+                      const SampleType *const *inputs,
+                      SampleType *const *outputs,
+                      int numSamples) noexcept
+    {
+        alignas(Vec) SampleType lanes[Lanes];
+
+        // * pull the coefficients and states of the active sections into locals for the whole block
+        constexpr auto capacity = KernelCapacity<NumSections>;
+        const auto numSections = getKernelSections<NumSections>();
+
+        std::array<Section, capacity> c;
+        std::array<Vec, capacity> s1, s2;
+
+        for (size_t n = 0; n < numSections; ++n)
+        {
+            const auto slot = (size_t)activeSlots[n];
+
+            c[n] = sections[n];
+            s1[n] = state.s1[slot];
+            s2[n] = state.s2[slot];
+        }
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            if constexpr (Modulated)
+                derived().modulateSections(c, numSections, lfo.next());
+
+            gatherLanes<MidSide>(lanes, inputs, i);
+
+            auto x = Vec::fromRawArray(lanes);
+
+            for (size_t n = 0; n < numSections; ++n)
+                x = Derived::processSection(c[n], s1[n], s2[n], x);
+
+            x.copyToRawArray(lanes);
+
+            scatterLanes<MidSide>(lanes, outputs, i);
+        }
+
+        for (size_t n = 0; n < numSections; ++n)
+        {
+            const auto slot = (size_t)activeSlots[n];
+
+            state.s1[slot] = s1[n];
+            state.s2[slot] = s2[n];
+        }
+    }
+};
@@ -0,0 +1,286 @@
+/*
+  ==============================================================================
+
+    CoefficientCache.h
+    Created: 16 Oct 2026 6:12:31pm
+    Author:  brccabral
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginUtilities.h"
+
+// * which design a cached band comes from
+enum CoefficientBand
+{
+    CoefficientBand_Peak,
+    CoefficientBand_LowCut,
+    CoefficientBand_HighCut,
+    CoefficientBand_MatchedPeak,
+    CoefficientBand_LowShelf,
+    CoefficientBand_HighShelf,
+    CoefficientBand_Notch
+};
+
+// * the design of one band, a band of the peak bank only uses the first section
+struct CachedBand
+{
+    std::array<BiquadCoeffs, MaxCutSections> sections;
+    bool isIdentity{false};
+};
+
+// * everything a band design depends on, unused fields are left at 0
+// * the parameters are quantized, so equal settings have equal bits
+struct CoefficientKey
+{
+    CoefficientBand band{CoefficientBand_Peak};
+    int slope{0};
+    float frequency{0.f}, quality{0.f}, gainInDecibels{0.f};
+    double sampleRate{0};
+};
+
+/*
+ Process wide memo of band designs, shared by every plugin instance and editor.
+ The table is fixed size, set associative with LRU replacement inside each set, so memory
+ is bounded and never allocated after construction.
+ A lookup is lock free: every slot is a seqlock over atomic words, a reader that overlaps a
+ write sees the sequence change and treats it as a miss. Writers (misses only) take a spin lock.
+ */
+class CoefficientCache
+{
+public:
+    static constexpr size_t NumSets = 128;
+    static constexpr size_t NumWays = 8;
+
+    // * hit rate and memory use for instrumentation, the counters are relaxed so the hit path stays lock free
+    // * and a snapshot taken while other threads look up is only approximately consistent
+    struct Stats
+    {
+        juce::uint64 hits, misses, evictions;
+        size_t numEntries, capacity;
+        size_t bytesUsed, bytesReserved;
+
+        double getHitRate() const noexcept { return hits + misses > 0 ? (double)hits / (double)(hits + misses) : 0.0; }
+    };
+
+    // * returns the cached design, or calls makeBand() and remembers its result
+    template <typename MakeBandFunction>
+    CachedBand getOrMake(const CoefficientKey &key, MakeBandFunction &&makeBand)
+    {
+        const auto words = packKey(key);
+        auto &set = sets[hashKey(words) % NumSets];
+
+        CachedBand band;
+        if (find(set, words, band))
+        {
+            hits.fetch_add(1, std::memory_order_relaxed);
+            return band;
+        }
+
+        misses.fetch_add(1, std::memory_order_relaxed);
+
+        band = makeBand();
+        insert(set, words, band);
+
+        return band;
+    }
+
+    Stats getStats() const noexcept
+    {
+        const auto entries = numEntries.load(std::memory_order_relaxed);
+
+        return {hits.load(std::memory_order_relaxed),
+                misses.load(std::memory_order_relaxed),
+                evictions.load(std::memory_order_relaxed),
+                entries,
+                NumSets * NumWays,
+                entries * sizeof(Slot),
+                sizeof(sets)};
+    }
+
+private:
+    static constexpr size_t NumKeyWords = 3;
+    static constexpr size_t NumValueWords = MaxCutSections * 5 + 1;
+
+    // * tells a filled slot from an empty one, an all zero key is still a valid key
+    static constexpr juce::uint64 occupiedBit = 1ull << 16;
+
+    using KeyWords = std::array<juce::uint64, NumKeyWords>;
+
+    struct Slot
+    {
+        // * odd while a writer is changing the slot
+        std::atomic<juce::uint32> sequence{0};
+        std::atomic<juce::uint32> lastUsed{0};
+        std::array<std::atomic<juce::uint64>, NumKeyWords> key{};
+        std::array<std::atomic<juce::uint64>, NumValueWords> value{};
+    };
+
+    using Set = std::array<Slot, NumWays>;
+
+    std::array<Set, NumSets> sets;
+
+    std::atomic<juce::uint32> useClock{0};
+    std::atomic<juce::uint64> hits{0}, misses{0}, evictions{0};
+    std::atomic<size_t> numEntries{0};
+
+    juce::SpinLock writeLock;
+
+    template <typename Type>
+    static juce::uint64 toBits(Type value) noexcept
+    {
+        static_assert(sizeof(Type) <= sizeof(juce::uint64));
+
+        juce::uint64 bits{0};
+        std::memcpy(&bits, &value, sizeof(value));
+        return bits;
+    }
+
+    static KeyWords packKey(const CoefficientKey &key) noexcept
+    {
+        return {(juce::uint64)key.band | ((juce::uint64)key.slope << 8) | occupiedBit | (toBits(key.frequency) << 32),
+                toBits(key.quality) | (toBits(key.gainInDecibels) << 32),
+                toBits(key.sampleRate)};
+    }
+
+    static size_t hashKey(const KeyWords &words) noexcept
+    {
+        juce::uint64 hash = 0x9e3779b97f4a7c15ull;
+
+        for (auto word : words)
+        {
+            hash ^= word + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+            hash ^= hash >> 31;
+            hash *= 0xbf58476d1ce4e5b9ull;
+        }
+
+        return (size_t)(hash ^ (hash >> 29));
+    }
+
+    static bool hasKey(const Slot &slot, const KeyWords &words) noexcept
+    {
+        for (size_t i = 0; i < NumKeyWords; ++i)
+            if (slot.key[i].load(std::memory_order_relaxed) != words[i])
+                return false;
+
+        return true;
+    }
+
+    bool find(Set &set, const KeyWords &words, CachedBand &band) noexcept
+    {
+        for (auto &slot : set)
+        {
+            const auto sequence = slot.sequence.load(std::memory_order_acquire);
+
+            if ((sequence & 1) != 0 || !hasKey(slot, words))
+                continue;
+
+            std::array<juce::uint64, NumValueWords> value;
+            for (size_t i = 0; i < NumValueWords; ++i)
+                value[i] = slot.value[i].load(std::memory_order_relaxed);
+
+            // * the copy only counts if no writer touched the slot meanwhile
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.sequence.load(std::memory_order_relaxed) != sequence)
+                continue;
+
+            unpackValue(value, band);
+            slot.lastUsed.store(useClock.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void insert(Set &set, const KeyWords &words, const CachedBand &band) noexcept
+    {
+        const juce::SpinLock::ScopedLockType lock(writeLock);
+
+        // * another thread may have designed the same band while this one did
+        for (auto &slot : set)
+            if (hasKey(slot, words))
+                return;
+
+        // * an empty slot, otherwise the least recently used one
+        Slot *victim = nullptr;
+        for (auto &slot : set)
+        {
+            if (slot.sequence.load(std::memory_order_relaxed) == 0)
+            {
+                victim = &slot;
+                break;
+            }
+
+            if (victim == nullptr || isOlder(slot.lastUsed.load(std::memory_order_relaxed), victim->lastUsed.load(std::memory_order_relaxed)))
+                victim = &slot;
+        }
+
+        const auto sequence = victim->sequence.load(std::memory_order_relaxed);
+
+        if (sequence == 0)
+            numEntries.fetch_add(1, std::memory_order_relaxed);
+        else
+            evictions.fetch_add(1, std::memory_order_relaxed);
+
+        victim->sequence.store(sequence + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        const auto value = packValue(band);
+        for (size_t i = 0; i < NumKeyWords; ++i)
+            victim->key[i].store(words[i], std::memory_order_relaxed);
+        for (size_t i = 0; i < NumValueWords; ++i)
+            victim->value[i].store(value[i], std::memory_order_relaxed);
+
+        victim->lastUsed.store(useClock.fetch_add(1, std::memory_order_relaxed), std::memory_order_relaxed);
+        victim->sequence.store(sequence + 2, std::memory_order_release);
+    }
+
+    // * the clock wraps, compare the distance instead of the values
+    static bool isOlder(juce::uint32 a, juce::uint32 b) noexcept { return (juce::int32)(a - b) < 0; }
+
+    static std::array<juce::uint64, NumValueWords> packValue(const CachedBand &band) noexcept
+    {
+        std::array<juce::uint64, NumValueWords> value;
+
+        for (size_t i = 0; i < MaxCutSections; ++i)
+        {
+            const auto &section = band.sections[i];
+            value[i * 5 + 0] = toBits(section.b0);
+            value[i * 5 + 1] = toBits(section.b1);
+            value[i * 5 + 2] = toBits(section.b2);
+            value[i * 5 + 3] = toBits(section.a1);
+            value[i * 5 + 4] = toBits(section.a2);
+        }
+
+        value[NumValueWords - 1] = band.isIdentity ? 1 : 0;
+
+        return value;
+    }
+
+    static void unpackValue(const std::array<juce::uint64, NumValueWords> &value, CachedBand &band) noexcept
+    {
+        auto fromBits = [](juce::uint64 bits)
+        {
+            double result;
+            std::memcpy(&result, &bits, sizeof(result));
+            return result;
+        };
+
+        for (size_t i = 0; i < MaxCutSections; ++i)
+            band.sections[i] = {fromBits(value[i * 5 + 0]), fromBits(value[i * 5 + 1]), fromBits(value[i * 5 + 2]),
+                                fromBits(value[i * 5 + 3]), fromBits(value[i * 5 + 4])};
+
+        band.isIdentity = value[NumValueWords - 1] != 0;
+    }
+};
+
+// * one cache for the whole process, every instance and editor designs through it
+inline CoefficientCache &getSharedCoefficientCache()
+{
+    static CoefficientCache cache;
+    return cache;
+}
@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    FrequencyTable.h
+    Created: 16 Oct 2026 7:24:09pm
+    Author:  brccabral
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginUtilities.h"
+#include "PluginParameters.h"
+
+/*
+ The frequency dependent part of the band designs for one sample rate, tabulated over the
+ skewed range of the frequency parameters. Sweeping a frequency at audio rate then costs an
+ interpolated lookup per sample instead of a std::tan.
+ The points are evenly spaced in the normalised knob position, so they are dense at low
+ frequencies, where the coefficients move fastest.
+ */
+class FrequencyTable
+{
+public:
+    static constexpr int NumPoints = 1024;
+
+    struct Point
+    {
+        // * tan(omega / 2), omega = 2 pi f / sr, the g of a state variable filter
+        double tanHalfOmega;
+    };
+
+    // * allocates and calls into libm, keep it away from the audio thread
+    // * a table that is already built for this rate is kept
+    void build(double newSampleRate)
+    {
+        if (newSampleRate == sampleRate)
+            return;
+
+        sampleRate = newSampleRate;
+
+        const auto range = makeFrequencyRange();
+        const auto nyquistLimit = sampleRate * 0.49;
+
+        // * one extra point, so the interpolation at position 1 doesn't read past the end
+        points.resize((size_t)NumPoints + 1);
+
+        for (size_t i = 0; i < points.size(); ++i)
+        {
+            auto position = juce::jmin(1.f, (float)i / (float)(NumPoints - 1));
+            auto frequency = juce::jmin((double)range.convertFrom0to1(position), nyquistLimit);
+            auto omega = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+
+            points[i] = {std::tan(omega * 0.5)};
+        }
+    }
+
+    double getSampleRate() const noexcept { return sampleRate; }
+
+    // * position is the normalised frequency knob value, clamped to 0 to 1
+    Point lookup(double position) const noexcept
+    {
+        jassert(!points.empty());
+
+        auto index = juce::jlimit(0.0, 1.0, position) * (NumPoints - 1);
+        auto i = (size_t)index;
+        auto fraction = index - (double)i;
+
+        const auto &a = points[i];
+        const auto &b = points[i + 1];
+
+        return {a.tanHalfOmega + fraction * (b.tanHalfOmega - a.tanHalfOmega)};
+    }
+
+private:
+    std::vector<Point> points;
+    double sampleRate = 0;
+};
+
+// * sine LFO as a rotating phasor, one complex multiply per sample instead of a std::sin
+class QuadratureLfo
+{
+public:
+    void setFrequency(double frequency, double sampleRate) noexcept
+    {
+        const auto angle = juce::MathConstants<double>::twoPi * frequency / sampleRate;
+
+        rotationCos = std::cos(angle);
+        rotationSin = std::sin(angle);
+    }
+
+    void reset() noexcept
+    {
+        cos = 1;
+        sin = 0;
+    }
+
+    // * the value for this sample, -1 to 1, and steps to the next one
+    double next() noexcept
+    {
+        const auto value = sin;
+
+        const auto newCos = cos * rotationCos - sin * rotationSin;
+        sin = sin * rotationCos + cos * rotationSin;
+        cos = newCos;
+
+        return value;
+    }
+
+    // * the rotation drifts off the unit circle by rounding, pull it back once per block
+    void normalise() noexcept
+    {
+        const auto magnitude = std::sqrt(cos * cos + sin * sin);
+
+        cos /= magnitude;
+        sin /= magnitude;
+    }
+
+private:
+    double cos = 1, sin = 0;
+    double rotationCos = 1, rotationSin = 0;
+};
@@ -0,0 +1,231 @@
+/*
+  ==============================================================================
+
+    LatencyBypass.h
+    Created: 16 Oct 2026 3:41:07pm
+    Author:  brccabral
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+
+/*
+ Cheap bypass for a processing path that adds latency (oversampling, linear phase FIR).
+ The input is always written to a delay line as long as the path latency, so when the path has
+ nothing to do it can be switched off and the delayed input is output instead, still in time.
+
+ Switching is a short linear crossfade between the two, both are aligned so it doesn't comb.
+ A path that was switched off has stale state, so it runs for warmUpSamples with its output
+ ignored before it is faded in.
+ Everything is allocated in prepare(), the rest is safe on the audio thread.
+ */
+template <typename SampleType>
+class LatencyBypass
+{
+public:
+    void prepare(int numChannels, int maxBlockSize, int maxLatencySamples)
+    {
+        delayBuffer.setSize(numChannels, maxLatencySamples + maxBlockSize);
+        dryBuffer.setSize(numChannels, maxBlockSize);
+
+        reset();
+    }
+
+    // * starts engaged with the delay line cleared
+    void reset() noexcept
+    {
+        delayBuffer.clear();
+        writePosition = 0;
+        state = State::Engaged;
+    }
+
+    // * call when the path changes, its latency is what the dry signal is delayed by
+    void setPath(int newLatencySamples, int newWarmUpSamples) noexcept
+    {
+        jassert(newLatencySamples + dryBuffer.getNumSamples() <= delayBuffer.getNumSamples());
+
+        latencySamples = newLatencySamples;
+        warmUpSamples = newWarmUpSamples;
+
+        reset();
+    }
+
+    void setFadeLength(int numSamples) noexcept { fadeSamples = juce::jmax(1, numSamples); }
+
+    // * stores the delayed input and tells if the path has to run for this block
+    // * pathNeeded is false when the path would only delay the signal
+    bool pushInput(const juce::AudioBuffer<SampleType> &input, bool pathNeeded) noexcept
+    {
+        const auto numSamples = input.getNumSamples();
+        const auto numChannels = juce::jmin(input.getNumChannels(), delayBuffer.getNumChannels());
+
+        jassert(numSamples <= dryBuffer.getNumSamples());
+
+        writeDelayLine(input, numChannels, numSamples);
+
+        switch (state)
+        {
+        case State::Bypassed:
+            if (pathNeeded)
+                startTransition(State::WarmingUp, warmUpSamples);
+            break;
+
+        case State::WarmingUp:
+            if (!pathNeeded)
+                state = State::Bypassed;
+            break;
+
+        case State::Engaged:
+            if (!pathNeeded)
+                startTransition(State::FadingOut, fadeSamples);
+            break;
+
+        // * turning around halfway through a fade continues from the current mix
+        case State::FadingIn:
+            if (!pathNeeded)
+                startTransition(State::FadingOut, fadeSamples - samplesLeft);
+            break;
+
+        case State::FadingOut:
+            if (pathNeeded)
+                startTransition(State::FadingIn, fadeSamples - samplesLeft);
+            break;
+        }
+
+        return state != State::Bypassed;
+    }
+
+    // * true on the first block the path runs after being off, so its state can be cleared
+    bool isStartingUp() const noexcept { return state == State::WarmingUp && samplesLeft == warmUpSamples; }
+
+    // * replaces or mixes the path output with the delayed input
+    void processOutput(juce::AudioBuffer<SampleType> &output) noexcept
+    {
+        const auto numSamples = output.getNumSamples();
+        const auto numChannels = juce::jmin(output.getNumChannels(), dryBuffer.getNumChannels());
+
+        for (int start = 0; start < numSamples;)
+        {
+            auto length = numSamples - start;
+
+            if (state == State::WarmingUp || state == State::FadingIn || state == State::FadingOut)
+                length = juce::jmin(length, samplesLeft);
+
+            switch (state)
+            {
+            case State::Engaged:
+                break;
+
+            case State::Bypassed:
+            case State::WarmingUp:
+                for (int channel = 0; channel < numChannels; ++channel)
+                    output.copyFrom(channel, start, dryBuffer, channel, start, length);
+                break;
+
+            case State::FadingIn:
+            case State::FadingOut:
+            {
+                // * gain of the path output at the start and the end of this piece
+                auto done = (SampleType)(fadeSamples - samplesLeft) / (SampleType)fadeSamples;
+                auto next = (SampleType)(fadeSamples - samplesLeft + length) / (SampleType)fadeSamples;
+
+                auto wetStart = state == State::FadingIn ? done : SampleType(1) - done;
+                auto wetEnd = state == State::FadingIn ? next : SampleType(1) - next;
+
+                for (int channel = 0; channel < numChannels; ++channel)
+                {
+                    output.applyGainRamp(channel, start, length, wetStart, wetEnd);
+                    output.addFromWithRamp(channel, start, dryBuffer.getReadPointer(channel, start), length,
+                                           SampleType(1) - wetStart, SampleType(1) - wetEnd);
+                }
+                break;
+            }
+            }
+
+            start += length;
+            advance(length);
+        }
+    }
+
+private:
+    enum class State
+    {
+        Bypassed,
+        WarmingUp,
+        FadingIn,
+        Engaged,
+        FadingOut
+    };
+
+    juce::AudioBuffer<SampleType> delayBuffer, dryBuffer;
+    int writePosition = 0;
+    int latencySamples = 0, warmUpSamples = 0, fadeSamples = 256;
+
+    State state = State::Engaged;
+    int samplesLeft = 0;
+
+    void startTransition(State newState, int numSamples) noexcept
+    {
+        state = newState;
+        samplesLeft = numSamples;
+
+        if (samplesLeft <= 0)
+            advance(0);
+    }
+
+    // * moves through the timed states, a piece never crosses the end of one
+    void advance(int numSamples) noexcept
+    {
+        if (state == State::Engaged || state == State::Bypassed)
+            return;
+
+        samplesLeft -= numSamples;
+
+        if (samplesLeft > 0)
+            return;
+
+        if (state == State::WarmingUp)
+            startTransition(State::FadingIn, fadeSamples);
+        else
+            state = state == State::FadingIn ? State::Engaged : State::Bypassed;
+    }
+
+    // * writes the block and reads it back latencySamples later into dryBuffer, block copies only
+    void writeDelayLine(const juce::AudioBuffer<SampleType> &input, int numChannels, int numSamples) noexcept
+    {
+        const auto size = delayBuffer.getNumSamples();
+        auto readPosition = writePosition - latencySamples;
+
+        if (readPosition < 0)
+            readPosition += size;
+
+        for (int channel = 0; channel < numChannels; ++channel)
+        {
+            copyIntoRing(delayBuffer, channel, writePosition, input.getReadPointer(channel), numSamples);
+            copyOutOfRing(delayBuffer, channel, readPosition, dryBuffer.getWritePointer(channel), numSamples);
+        }
+
+        writePosition = (writePosition + numSamples) % size;
+    }
+
+    static void copyIntoRing(juce::AudioBuffer<SampleType> &ring, int channel, int position, const SampleType *source, int numSamples) noexcept
+    {
+        const auto first = juce::jmin(numSamples, ring.getNumSamples() - position);
+
+        ring.copyFrom(channel, position, source, first);
+        if (first < numSamples)
+            ring.copyFrom(channel, 0, source + first, numSamples - first);
+    }
+
+    static void copyOutOfRing(const juce::AudioBuffer<SampleType> &ring, int channel, int position, SampleType *destination, int numSamples) noexcept
+    {
+        const auto first = juce::jmin(numSamples, ring.getNumSamples() - position);
+
+        juce::FloatVectorOperations::copy(destination, ring.getReadPointer(channel, position), first);
+        if (first < numSamples)
+            juce::FloatVectorOperations::copy(destination + first, ring.getReadPointer(channel), numSamples - first);
+    }
+};
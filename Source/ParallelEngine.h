@@ -0,0 +1,230 @@
+/*
+  ==============================================================================
+
+    ParallelEngine.h
+    Created: 16 Oct 2026 9:27:44pm
+    Author:  brccabral
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginUtilities.h"
+#include "FrequencyTable.h"
+#include "ChainEngine.h"
+
+static_assert(MaxChainSections == NumChainSlots, "parallel sections are indexed like the chain slots");
+
+inline ParallelSection interpolate(const ParallelSection &a, const ParallelSection &b, double t) noexcept
+{
+    return {interpolate(a.b1, b.b1, t), interpolate(a.b2, b.b2, t), interpolate(a.a1, b.a1, t), interpolate(a.a2, b.a2, t)};
+}
+
+/*
+ The LowCut -> peak bank -> HighCut chain as a sum instead of a cascade: a direct path plus one second
+ order section per active biquad, from makeParallelCoefficients() on the designer thread.
+ A section's numerator has no b0, so its output only depends on past input, and no section waits
+ for another one. The sections of one channel are packed side by side in the SIMD lanes and the
+ whole chain is a handful of independent multiply-adds per sample, even for mono.
+
+ The sections run in double whatever the host precision: the residues of a steep chain are large
+ and cancel each other, rounding them to float changes the response by several dB.
+ Same slots and same interface as MultiChannelChain, from the same ChainEngine. New coefficients
+ glide linearly per slot in (b1, b2, a1, a2) and in the direct gain, every point keeps the stable
+ denominators of the cascade. Sections switching on or off fade their numerator from or to 0.
+ The parallel form isn't modulated, makeChainCoefficients() picks the biquads for that.
+ */
+template <typename SampleType>
+class MultiChannelParallelChain : public ChainEngine<MultiChannelParallelChain<SampleType>, ParallelSection, double>
+{
+    using Base = ChainEngine<MultiChannelParallelChain<SampleType>, ParallelSection, double>;
+    friend Base;
+
+public:
+    using Vec = juce::dsp::SIMDRegister<double>;
+    static constexpr int Lanes = (int)Vec::size();
+    static constexpr int MaxVectors = (NumChainSlots + Lanes - 1) / Lanes;
+
+    // * the same setup as the other chains, there is nothing to modulate here
+    void setFrequencyTable(const FrequencyTable *) noexcept {}
+
+private:
+    // * Lanes sections side by side
+    struct SectionGroup
+    {
+        Vec b1, b2, a1, a2;
+    };
+
+    // * per channel and per slot, so it survives the sections being packed differently
+    struct ChannelState
+    {
+        std::array<double, NumChainSlots> s1, s2;
+    };
+
+    // * runs one channel through the packed sections
+    using ChannelKernel = void (MultiChannelParallelChain::*)(ChannelState &, const SampleType *, SampleType *, int) noexcept;
+
+    // * packed in processing order, lane l of sectionGroups[v] is slot activeSlots[v * Lanes + l]
+    // * lanes past the last active section are all 0 and stay silent
+    std::array<SectionGroup, MaxVectors> sectionGroups;
+    std::array<int, NumChainSlots> activeSlots{};
+    int numActive = 0;
+    double packedDirect = 1.0;
+    ChannelKernel kernel = getKernel(0);
+
+    std::vector<ChannelState> states;
+
+    void prepareState() { states.resize((size_t)this->numChannels); }
+
+    void clearState() noexcept
+    {
+        for (auto &state : states)
+        {
+            state.s1.fill(0.0);
+            state.s2.fill(0.0);
+        }
+    }
+
+    void clearState(size_t slot) noexcept
+    {
+        for (auto &state : states)
+        {
+            state.s1[slot] = 0.0;
+            state.s2[slot] = 0.0;
+        }
+    }
+
+    void setTargets(const ChainCoefficients &chainCoefficients) noexcept
+    {
+        this->targetParameters = chainCoefficients.parallel.sections;
+        this->targetChain = chainCoefficients.parallel.direct;
+    }
+
+    void pack() noexcept
+    {
+        numActive = 0;
+
+        for (size_t slot = 0; slot < NumChainSlots; ++slot)
+            if (this->active[slot])
+                activeSlots[(size_t)numActive++] = (int)slot;
+
+        const auto numVectors = (numActive + Lanes - 1) / Lanes;
+
+        for (int v = 0; v < numVectors; ++v)
+        {
+            alignas(Vec) double b1[Lanes], b2[Lanes], a1[Lanes], a2[Lanes];
+
+            for (int l = 0; l < Lanes; ++l)
+            {
+                const auto n = v * Lanes + l;
+                const auto slot = n < numActive ? (size_t)activeSlots[(size_t)n] : 0;
+                const auto section = n < numActive ? this->currentParameters[slot] : ParallelSection{};
+
+                // * a section fading in or out has its poles, the weight scales what it adds to the sum
+                const auto weight = n < numActive ? this->currentWeight[slot] : 0.0;
+
+                b1[l] = weight * section.b1;
+                b2[l] = weight * section.b2;
+                a1[l] = section.a1;
+                a2[l] = section.a2;
+            }
+
+            sectionGroups[(size_t)v] = {Vec::fromRawArray(b1), Vec::fromRawArray(b2), Vec::fromRawArray(a1), Vec::fromRawArray(a2)};
+        }
+
+        packedDirect = this->currentChain;
+
+        // * the plan only changes here, the blocks in between run the kernel picked now
+        kernel = getKernel(numVectors);
+    }
+
+    bool isPassThrough() const noexcept { return numActive == 0 && packedDirect == 1.0; }
+
+    template <typename InputBlock, typename OutputBlock>
+    void processSamples(const InputBlock &inputBlock, const OutputBlock &outputBlock, int channels, int numSamples) noexcept
+    {
+        for (int channel = 0; channel < channels; ++channel)
+            (this->*kernel)(states[(size_t)channel],
+                            inputBlock.getChannelPointer((size_t)channel),
+                            outputBlock.getChannelPointer((size_t)channel),
+                            numSamples);
+    }
+
+    // * one straight line kernel per number of section groups
+    template <size_t... NumVectors>
+    static constexpr auto makeKernelTable(std::index_sequence<NumVectors...>) noexcept
+    {
+        return std::array<ChannelKernel, sizeof...(NumVectors)>{{&MultiChannelParallelChain::processChannel<(int)NumVectors>...}};
+    }
+
+    static ChannelKernel getKernel(int numVectors) noexcept
+    {
+        static constexpr auto kernels = makeKernelTable(std::make_index_sequence<MaxVectors + 1>{});
+        return kernels[(size_t)numVectors];
+    }
+
+    template <int NumVectors>
+    void processChannel(ChannelState &state, const SampleType *input, SampleType *output, int numSamples) noexcept
+    {
+        alignas(Vec) double lanes1[Lanes], lanes2[Lanes];
+
+        // * pull the coefficients and states of the packed sections into locals for the whole block
+        std::array<SectionGroup, (size_t)NumVectors> c;
+        std::array<Vec, (size_t)NumVectors> s1, s2;
+
+        for (int v = 0; v < NumVectors; ++v)
+        {
+            for (int l = 0; l < Lanes; ++l)
+            {
+                const auto n = v * Lanes + l;
+                const auto slot = n < numActive ? (size_t)activeSlots[(size_t)n] : 0;
+
+                lanes1[l] = n < numActive ? state.s1[slot] : 0.0;
+                lanes2[l] = n < numActive ? state.s2[slot] : 0.0;
+            }
+
+            c[(size_t)v] = sectionGroups[(size_t)v];
+            s1[(size_t)v] = Vec::fromRawArray(lanes1);
+            s2[(size_t)v] = Vec::fromRawArray(lanes2);
+        }
+
+        const auto direct = packedDirect;
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto x = (double)input[i];
+            const auto xs = Vec::expand(x);
+            auto sum = Vec::expand(0.0);
+
+            // * without b0 a section's output is its first state, the update only feeds the next sample
+            for (size_t v = 0; v < (size_t)NumVectors; ++v)
+            {
+                const auto y = s1[v];
+                s1[v] = c[v].b1 * xs - c[v].a1 * y + s2[v];
+                s2[v] = c[v].b2 * xs - c[v].a2 * y;
+                sum += y;
+            }
+
+            output[i] = (SampleType)(direct * x + sum.sum());
+        }
+
+        for (int v = 0; v < NumVectors; ++v)
+        {
+            s1[(size_t)v].copyToRawArray(lanes1);
+            s2[(size_t)v].copyToRawArray(lanes2);
+
+            for (int l = 0; l < Lanes; ++l)
+            {
+                const auto n = v * Lanes + l;
+
+                if (n < numActive)
+                {
+                    state.s1[(size_t)activeSlots[(size_t)n]] = lanes1[l];
+                    state.s2[(size_t)activeSlots[(size_t)n]] = lanes2[l];
+                }
+            }
+        }
+    }
+};
@@ -429,66 +429,55 @@ void ResponseCurveComponent::updateResponseCurve()
     auto responseArea = getAnalysisArea();
     auto w = responseArea.getWidth();
 
-    auto &lowCut = monoChain.get<ChainPositions::LowCut>();
-    auto &peak = monoChain.get<ChainPositions::Peak>();
-    auto &highCut = monoChain.get<ChainPositions::HighCut>();
+    auto sampleRate = chainSampleRate;
 
-    auto sampleRate = audioProcessor.getSampleRate();
+    // * chart limits
+    const double outputMin = responseArea.getBottom();
+    const double outputMax = responseArea.getY();
+    auto map = [outputMin, outputMax](double input)
+    {
+        // * -24 to 24 comes from "Peak Gain"
+        return jmap(input, -24.0, 24.0, outputMin, outputMax);
+    };
 
-    // * calculate Magnitude for each filter, combine them and store in the vector
     std::vector<double> mags; // * magnitudes
     mags.resize(w);
 
-    for (int i = 0; i < w; ++i)
+    auto drawCurve = [&](Path &curve, const ChainCoefficients &chain)
     {
-        double mag = 1.f;
-        auto freq = mapToLog10((double(i) / double(w)), 20.0, 20000.0);
-
-        if (!monoChain.isBypassed<ChainPositions::Peak>())
-            mag *= peak.coefficients->getMagnitudeForFrequency(freq, sampleRate);
-
-        if (!monoChain.isBypassed<ChainPositions::LowCut>())
+        // * calculate Magnitude for each active section, the whole bank included, combine them and store in the vector
+        for (int i = 0; i < w; ++i)
         {
-            if (!lowCut.isBypassed<0>())
-                mag *= lowCut.get<0>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if (!lowCut.isBypassed<1>())
-                mag *= lowCut.get<1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if (!lowCut.isBypassed<2>())
-                mag *= lowCut.get<2>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if (!lowCut.isBypassed<3>())
-                mag *= lowCut.get<3>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
+            auto freq = mapToLog10((double(i) / double(w)), 20.0, 20000.0);
+            auto mag = getMagnitudeForFrequency(chain, freq, sampleRate);
+
+            mags[i] = Decibels::gainToDecibels(mag);
         }
 
-        if (!monoChain.isBypassed<ChainPositions::HighCut>())
+        // * draw chart
+        curve.clear();
+        curve.startNewSubPath(responseArea.getX(), map(mags.front()));
+        for (size_t i = 1; i < mags.size(); ++i)
         {
-            if (!highCut.isBypassed<0>())
-                mag *= highCut.get<0>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if (!highCut.isBypassed<1>())
-                mag *= highCut.get<1>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if (!highCut.isBypassed<2>())
-                mag *= highCut.get<2>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
-            if (!highCut.isBypassed<3>())
-                mag *= highCut.get<3>().coefficients->getMagnitudeForFrequency(freq, sampleRate);
+            curve.lineTo(responseArea.getX() + i, map(mags[i]));
         }
+    };
 
-        mags[i] = Decibels::gainToDecibels(mag);
-    }
+    // * a band placed on mid or side only filters that one, the two get their own curves
+    const auto &bandChannels = chainCoefficients.bandChannels;
+    const auto isPlaced = chainCoefficients.midSide
+                          && std::any_of(bandChannels.begin(), bandChannels.end(), [](BandChannels channels)
+                                         { return channels != BandChannels_Both; });
 
-    // * chart limits
-    const double outputMin = responseArea.getBottom();
-    const double outputMax = responseArea.getY();
-    auto map = [outputMin, outputMax](double input)
+    if (isPlaced)
     {
-        // * -24 to 24 comes from "Peak Gain"
-        return jmap(input, -24.0, 24.0, outputMin, outputMax);
-    };
-
-    // * draw chart
-    responseCurve.clear();
-    responseCurve.startNewSubPath(responseArea.getX(), map(mags.front()));
-    for (size_t i = 1; i < mags.size(); ++i)
+        drawCurve(responseCurve, getMidSideChain(chainCoefficients, 0));
+        drawCurve(sideResponseCurve, getMidSideChain(chainCoefficients, 1));
+    }
+    else
     {
-        responseCurve.lineTo(responseArea.getX() + i, map(mags[i]));
+        drawCurve(responseCurve, chainCoefficients);
+        sideResponseCurve.clear();
     }
 }
 
@@ -537,6 +526,20 @@ void ResponseCurveComponent::paint(juce::Graphics &g)
     // * draw filter curve
     g.setColour(Colours::white);
     g.strokePath(responseCurve, PathStrokeType(2.f));
+
+    if (!sideResponseCurve.isEmpty())
+    {
+        g.setColour(Colours::lightgreen);
+        g.strokePath(sideResponseCurve, PathStrokeType(2.f));
+
+        // * which curve is which
+        auto legendArea = responseArea.reduced(4).removeFromTop(14);
+        g.setFont(12);
+        g.setColour(Colours::white);
+        g.drawFittedText("Mid", legendArea.removeFromLeft(30), Justification::centredLeft, 1);
+        g.setColour(Colours::lightgreen);
+        g.drawFittedText("Side", legendArea.removeFromLeft(30), Justification::centredLeft, 1);
+    }
 }
 
 void ResponseCurveComponent::resized()
@@ -544,6 +547,7 @@ void ResponseCurveComponent::resized()
     using namespace juce;
 
     responseCurve.preallocateSpace(getWidth() * 3);
+    sideResponseCurve.preallocateSpace(getWidth() * 3);
     updateResponseCurve();
 }
 
@@ -551,33 +555,29 @@ void ResponseCurveComponent::resized()
 AudioPlugin_JUCEAudioProcessorEditor::AudioPlugin_JUCEAudioProcessorEditor(
     AudioPlugin_JUCEAudioProcessor &p)
     : AudioProcessorEditor(&p), audioProcessor(p),
-      // * sliders attachments
-      peakFreqSliderAttachment(audioProcessor.apvts, "Peak Freq", peakFreqSlider),
-      peakGainSliderAttachment(audioProcessor.apvts, "Peak Gain", peakGainSlider),
-      peakQualitySliderAttachment(audioProcessor.apvts, "Peak Quality", peakQualitySlider),
-      lowCutFreqSliderAttachment(audioProcessor.apvts, "LowCut Freq", lowCutFreqSlider),
-      highCutFreqSliderAttachment(audioProcessor.apvts, "HighCut Freq", highCutFreqSlider),
-      lowCutSlopeSliderAttachment(audioProcessor.apvts, "LowCut Slope", lowCutSlopeSlider),
-      highCutSlopeSliderAttachment(audioProcessor.apvts, "HighCut Slope", highCutSlopeSlider),
+      // * sliders attachments, the Peak ones follow the band selector, see attachPeakBand()
+      lowCutFreqSliderAttachment(audioProcessor.apvts, getParameterID(Parameter_LowCutFreq), lowCutFreqSlider),
+      highCutFreqSliderAttachment(audioProcessor.apvts, getParameterID(Parameter_HighCutFreq), highCutFreqSlider),
+      lowCutSlopeSliderAttachment(audioProcessor.apvts, getParameterID(Parameter_LowCutSlope), lowCutSlopeSlider),
+      highCutSlopeSliderAttachment(audioProcessor.apvts, getParameterID(Parameter_HighCutSlope), highCutSlopeSlider),
       // * chart
       responseCurveComponent(audioProcessor),
       // * sliders components
-      peakFreqSlider(*audioProcessor.apvts.getParameter("Peak Freq"), "Hz"),
-      peakGainSlider(*audioProcessor.apvts.getParameter("Peak Gain"), "dB"),
-      peakQualitySlider(*audioProcessor.apvts.getParameter("Peak Quality"), ""),
-      lowCutFreqSlider(*audioProcessor.apvts.getParameter("LowCut Freq"), "Hz"),
-      highCutFreqSlider(*audioProcessor.apvts.getParameter("HighCut Freq"), "Hz"),
-      lowCutSlopeSlider(*audioProcessor.apvts.getParameter("LowCut Slope"), "dB/Oct"),
-      highCutSlopeSlider(*audioProcessor.apvts.getParameter("HighCut Slope"), "db/Oct"),
+      peakFreqSlider(*audioProcessor.apvts.getParameter(getParameterID(Parameter_PeakFreq)), "Hz"),
+      peakGainSlider(*audioProcessor.apvts.getParameter(getParameterID(Parameter_PeakGain)), "dB"),
+      peakQualitySlider(*audioProcessor.apvts.getParameter(getParameterID(Parameter_PeakQuality)), ""),
+      lowCutFreqSlider(*audioProcessor.apvts.getParameter(getParameterID(Parameter_LowCutFreq)), "Hz"),
+      highCutFreqSlider(*audioProcessor.apvts.getParameter(getParameterID(Parameter_HighCutFreq)), "Hz"),
+      lowCutSlopeSlider(*audioProcessor.apvts.getParameter(getParameterID(Parameter_LowCutSlope)), "dB/Oct"),
+      highCutSlopeSlider(*audioProcessor.apvts.getParameter(getParameterID(Parameter_HighCutSlope)), "db/Oct"),
       // * bypass
-      lowcutBypassButtonAttachment(audioProcessor.apvts, "LowCut Bypassed", lowcutBypassButton),
-      peakBypassButtonAttachment(audioProcessor.apvts, "Peak Bypassed", peakBypassButton),
-      highcutBypassButtonAttachment(audioProcessor.apvts, "HighCut Bypassed", highcutBypassButton),
-      analyzerEnabledButtonAttachment(audioProcessor.apvts, "Analyzer Enabled", analyzerEnabledButton)
+      lowcutBypassButtonAttachment(audioProcessor.apvts, getParameterID(Parameter_LowCutBypassed), lowcutBypassButton),
+      highcutBypassButtonAttachment(audioProcessor.apvts, getParameterID(Parameter_HighCutBypassed), highcutBypassButton),
+      analyzerEnabledButtonAttachment(audioProcessor.apvts, getParameterID(Parameter_AnalyzerEnabled), analyzerEnabledButton)
 {
     // Make sure that before the constructor has finished, you've set the
     // editor's size to whatever you need it to be.
-    setSize(480, 500);
+    setSize(480, 525);
 
     peakFreqSlider.labels.add({0.f, "20Hz"});
     peakFreqSlider.labels.add({1.f, "20kHz"});
@@ -600,6 +600,20 @@ AudioPlugin_JUCEAudioProcessorEditor::AudioPlugin_JUCEAudioProcessorEditor(
     highCutSlopeSlider.labels.add({0.0f, "12"});
     highCutSlopeSlider.labels.add({1.f, "48"});
 
+    // * the attachments pick their item by index, the items must be there first
+    for (int count = 1; count <= MaxPeakBands; ++count)
+        peakBandCount.addItem(juce::String(count) + (count == 1 ? " band" : " bands"), count);
+
+    for (int type = 0; type < (int)std::size(peakTypeChoices); ++type)
+        peakTypeSelector.addItem(peakTypeChoices[type], type + 1);
+
+    for (int steep = 0; steep < (int)std::size(steepSlopeChoices); ++steep)
+    {
+        const auto text = steep == 0 ? juce::String("Steep Off") : juce::String(steepSlopeChoices[steep]);
+        lowCutSteepSlopeSelector.addItem(text, steep + 1);
+        highCutSteepSlopeSelector.addItem(text, steep + 1);
+    }
+
     for (auto *comp : getComps())
         addAndMakeVisible(comp);
 
@@ -619,29 +633,20 @@ AudioPlugin_JUCEAudioProcessorEditor::AudioPlugin_JUCEAudioProcessorEditor(
             comp->peakFreqSlider.setEnabled(!bypassed);
             comp->peakGainSlider.setEnabled(!bypassed);
             comp->peakQualitySlider.setEnabled(!bypassed);
+            comp->peakTypeSelector.setEnabled(!bypassed);
         }
     };
 
     lowcutBypassButton.onClick = [safePtr]()
     {
         if (auto *comp = safePtr.getComponent())
-        {
-            auto bypassed = comp->lowcutBypassButton.getToggleState();
-
-            comp->lowCutFreqSlider.setEnabled(!bypassed);
-            comp->lowCutSlopeSlider.setEnabled(!bypassed);
-        }
+            comp->updateCutControls();
     };
 
     highcutBypassButton.onClick = [safePtr]()
     {
         if (auto *comp = safePtr.getComponent())
-        {
-            auto bypassed = comp->highcutBypassButton.getToggleState();
-
-            comp->highCutFreqSlider.setEnabled(!bypassed);
-            comp->highCutSlopeSlider.setEnabled(!bypassed);
-        }
+            comp->updateCutControls();
     };
 
     analyzerEnabledButton.onClick = [safePtr]()
@@ -652,6 +657,104 @@ AudioPlugin_JUCEAudioProcessorEditor::AudioPlugin_JUCEAudioProcessorEditor(
             comp->responseCurveComponent.toggleAnalysisEnablement(enabled);
         }
     };
+
+    peakBandSelector.onChange = [safePtr]()
+    {
+        if (auto *comp = safePtr.getComponent())
+            comp->attachPeakBand(comp->peakBandSelector.getSelectedId() - 1);
+    };
+
+    // * also called when the host or a preset changes "Peak Bands"
+    peakBandCount.onChange = [safePtr]()
+    {
+        if (auto *comp = safePtr.getComponent())
+            comp->updatePeakBandSelector();
+    };
+
+    peakBandCountAttachment = std::make_unique<ComboBoxAttachment>(audioProcessor.apvts, getParameterID(Parameter_NumPeakBands), peakBandCount);
+
+    // * also called when the host or a preset changes "Steep Slope"
+    lowCutSteepSlopeSelector.onChange = [safePtr]()
+    {
+        if (auto *comp = safePtr.getComponent())
+            comp->updateCutControls();
+    };
+
+    highCutSteepSlopeSelector.onChange = lowCutSteepSlopeSelector.onChange;
+
+    lowCutSteepSlopeAttachment = std::make_unique<ComboBoxAttachment>(audioProcessor.apvts, getParameterID(Parameter_LowCutSteepSlope), lowCutSteepSlopeSelector);
+    highCutSteepSlopeAttachment = std::make_unique<ComboBoxAttachment>(audioProcessor.apvts, getParameterID(Parameter_HighCutSteepSlope), highCutSteepSlopeSelector);
+
+    updatePeakBandSelector();
+    updateCutControls();
+}
+
+void AudioPlugin_JUCEAudioProcessorEditor::updateCutControls()
+{
+    // * the Slope knob only applies while "Steep Slope" is Off, see getCutSlope()
+    auto lowCutBypassed = lowcutBypassButton.getToggleState();
+    auto lowCutSteep = lowCutSteepSlopeSelector.getSelectedId() > 1;
+
+    lowCutFreqSlider.setEnabled(!lowCutBypassed);
+    lowCutSteepSlopeSelector.setEnabled(!lowCutBypassed);
+    lowCutSlopeSlider.setEnabled(!lowCutBypassed && !lowCutSteep);
+
+    auto highCutBypassed = highcutBypassButton.getToggleState();
+    auto highCutSteep = highCutSteepSlopeSelector.getSelectedId() > 1;
+
+    highCutFreqSlider.setEnabled(!highCutBypassed);
+    highCutSteepSlopeSelector.setEnabled(!highCutBypassed);
+    highCutSlopeSlider.setEnabled(!highCutBypassed && !highCutSteep);
+}
+
+void AudioPlugin_JUCEAudioProcessorEditor::updatePeakBandSelector()
+{
+    // * only the first "Peak Bands" bands are processed, a band past them would be edited without being heard
+    const auto numBands = juce::jmax(1, peakBandCount.getSelectedId());
+    const auto selected = juce::jlimit(1, numBands, peakBandSelector.getSelectedId());
+
+    peakBandSelector.clear(juce::dontSendNotification);
+
+    for (int band = 0; band < numBands; ++band)
+        peakBandSelector.addItem("Band " + juce::String(band + 1), band + 1);
+
+    peakBandSelector.setSelectedId(selected, juce::dontSendNotification);
+
+    if (selected - 1 != attachedPeakBand)
+        attachPeakBand(selected - 1);
+}
+
+void AudioPlugin_JUCEAudioProcessorEditor::attachPeakBand(int band)
+{
+    auto &apvts = audioProcessor.apvts;
+
+    // * the old attachments go first, they would write the new band's values to the old band's parameters
+    peakFreqSliderAttachment.reset();
+    peakGainSliderAttachment.reset();
+    peakQualitySliderAttachment.reset();
+    peakBypassButtonAttachment.reset();
+    peakTypeAttachment.reset();
+
+    attachedPeakBand = band;
+
+    const auto freqID = getParameterID(getPeakBandParameter(band, PeakBand_Freq));
+    const auto gainID = getParameterID(getPeakBandParameter(band, PeakBand_Gain));
+    const auto qualityID = getParameterID(getPeakBandParameter(band, PeakBand_Quality));
+    const auto bypassedID = getParameterID(getPeakBandParameter(band, PeakBand_Bypassed));
+    const auto typeID = getParameterID(getPeakBandParameter(band, PeakBand_Type));
+
+    peakFreqSlider.setParameter(*apvts.getParameter(freqID));
+    peakGainSlider.setParameter(*apvts.getParameter(gainID));
+    peakQualitySlider.setParameter(*apvts.getParameter(qualityID));
+
+    peakFreqSliderAttachment = std::make_unique<Attachment>(apvts, freqID, peakFreqSlider);
+    peakGainSliderAttachment = std::make_unique<Attachment>(apvts, gainID, peakGainSlider);
+    peakQualitySliderAttachment = std::make_unique<Attachment>(apvts, qualityID, peakQualitySlider);
+    peakBypassButtonAttachment = std::make_unique<ButtonAttachment>(apvts, bypassedID, peakBypassButton);
+    peakTypeAttachment = std::make_unique<ComboBoxAttachment>(apvts, typeID, peakTypeSelector);
+
+    // * the toggle may not have changed, the knobs still need the new band's bypass
+    peakBypassButton.onClick();
 }
 
 AudioPlugin_JUCEAudioProcessorEditor::~AudioPlugin_JUCEAudioProcessorEditor()
@@ -753,14 +856,20 @@ void AudioPlugin_JUCEAudioProcessorEditor::resized()
     auto highCutArea = bounds.removeFromRight(bounds.getWidth() * 0.5); // * 50% of the rest (1 - 0.33)
 
     lowcutBypassButton.setBounds(lowCutArea.removeFromTop(25));
+    lowCutSteepSlopeSelector.setBounds(lowCutArea.removeFromTop(25).reduced(10, 2));
     lowCutFreqSlider.setBounds(lowCutArea.removeFromTop(lowCutArea.getHeight() * 0.5));
     lowCutSlopeSlider.setBounds(lowCutArea);
 
     highcutBypassButton.setBounds(highCutArea.removeFromTop(25));
+    highCutSteepSlopeSelector.setBounds(highCutArea.removeFromTop(25).reduced(10, 2));
     highCutFreqSlider.setBounds(highCutArea.removeFromTop(highCutArea.getHeight() * 0.5));
     highCutSlopeSlider.setBounds(highCutArea);
 
     peakBypassButton.setBounds(bounds.removeFromTop(25));
+    auto peakBandArea = bounds.removeFromTop(25).reduced(10, 2);
+    peakBandCount.setBounds(peakBandArea.removeFromLeft(peakBandArea.getWidth() / 2).withTrimmedRight(2));
+    peakBandSelector.setBounds(peakBandArea.withTrimmedLeft(2));
+    peakTypeSelector.setBounds(bounds.removeFromTop(25).reduced(10, 2));
     peakFreqSlider.setBounds(bounds.removeFromTop(bounds.getHeight() * 0.33));
     peakGainSlider.setBounds(bounds.removeFromTop(bounds.getHeight() * 0.5)); // * 50% of the rest (1 - 0.33)
     peakQualitySlider.setBounds(bounds);
@@ -779,6 +888,11 @@ std::vector<juce::Component *> AudioPlugin_JUCEAudioProcessorEditor::getComps()
         &responseCurveComponent,
         &lowcutBypassButton,
         &peakBypassButton,
+        &peakBandCount,
+        &peakBandSelector,
+        &peakTypeSelector,
+        &lowCutSteepSlopeSelector,
+        &highCutSteepSlopeSelector,
         &highcutBypassButton,
         &analyzerEnabledButton};
 }
@@ -872,20 +986,16 @@ void ResponseCurveComponent::timerCallback()
 
 void ResponseCurveComponent::updateChain()
 {
-    // * update the monochain
-    auto chainSettings = getChainSettings(audioProcessor.apvts);
+    // * update the chain
+    auto chainSettings = getChainSettings(audioProcessor.parameterHandles);
 
-    monoChain.setBypassed<ChainPositions::Peak>(chainSettings.peakBypassed);
-    auto peakCoefficients = makePeakFilter(chainSettings, audioProcessor.getSampleRate());
-    updateCoefficients(monoChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
+    // * match the processor, which designs for the rate the chain runs at
+    if (chainSettings.processingMode == ProcessingMode::LinearPhase)
+        chainSettings.oversampling = OversamplingFactor::Oversampling_Off;
 
-    monoChain.setBypassed<ChainPositions::LowCut>(chainSettings.lowCutBypassed);
-    auto lowCutCoefficients = makeLowCutFilter(chainSettings, audioProcessor.getSampleRate());
-    updateCutFilter(monoChain.get<ChainPositions::LowCut>(), lowCutCoefficients, chainSettings.lowCutSlope);
+    chainSampleRate = audioProcessor.getSampleRate() * (1 << chainSettings.oversampling);
 
-    monoChain.setBypassed<ChainPositions::HighCut>(chainSettings.highCutBypassed);
-    auto highCutCoefficients = makeHighCutFilter(chainSettings, audioProcessor.getSampleRate());
-    updateCutFilter(monoChain.get<ChainPositions::HighCut>(), highCutCoefficients, chainSettings.highCutSlope);
+    chainCoefficients = makeChainCoefficients(chainSettings, chainSampleRate);
 }
 
 juce::Rectangle<int> ResponseCurveComponent::getRenderArea()
@@ -197,6 +197,13 @@ struct RotarySliderWithLabels : juce::Slider
 
     juce::Array<LabelPos> labels;
 
+    // * the knob shows another parameter of the same range, its attachment is made again for it
+    void setParameter(juce::RangedAudioParameter &rap)
+    {
+        param = &rap;
+        repaint();
+    }
+
 private:
     juce::RangedAudioParameter *param;
     juce::String suffix;
@@ -256,7 +263,11 @@ struct ResponseCurveComponent : juce::Component,
 private:
     AudioPlugin_JUCEAudioProcessor &audioProcessor;
 
-    MonoChain monoChain;
+    // * the chain the curve is drawn from, designed like the processor's
+    ChainCoefficients chainCoefficients;
+
+    // * rate the chain was designed for, higher than the host rate when oversampling
+    double chainSampleRate = 44100.0;
 
     // * AudioProcessorParameter::Listener needs to be thread-safe and non-blocking
     juce::Atomic<bool> parametersChanged{false};
@@ -272,7 +283,8 @@ private:
     juce::Rectangle<int> getRenderArea();
     juce::Rectangle<int> getAnalysisArea();
 
-    juce::Path responseCurve;
+    // * with a band placed on mid or side, responseCurve is the mid and sideResponseCurve the side
+    juce::Path responseCurve, sideResponseCurve;
     void updateResponseCurve();
 
     PathProducer leftPathProducer, rightPathProducer;
@@ -340,14 +352,35 @@ private:
     using APVTS = juce::AudioProcessorValueTreeState;
     using Attachment = APVTS::SliderAttachment;
 
-    Attachment peakFreqSliderAttachment,
+    using ComboBoxAttachment = APVTS::ComboBoxAttachment;
+
+    // * "Peak Bands", the selector only offers the bands that run
+    juce::ComboBox peakBandCount;
+    std::unique_ptr<ComboBoxAttachment> peakBandCountAttachment;
+
+    // * the Peak knobs, type and bypass edit the band picked here, made again when it changes
+    juce::ComboBox peakBandSelector, peakTypeSelector;
+    std::unique_ptr<Attachment> peakFreqSliderAttachment,
         peakGainSliderAttachment,
-        peakQualitySliderAttachment,
-        lowCutFreqSliderAttachment,
+        peakQualitySliderAttachment;
+    std::unique_ptr<ComboBoxAttachment> peakTypeAttachment;
+    int attachedPeakBand = -1;
+
+    void attachPeakBand(int band);
+    void updatePeakBandSelector();
+
+    Attachment lowCutFreqSliderAttachment,
         highCutFreqSliderAttachment,
         lowCutSlopeSliderAttachment,
         highCutSlopeSliderAttachment;
 
+    // * "Steep Slope", past 48 dB/Oct it takes over from the Slope knob, which is then greyed out
+    juce::ComboBox lowCutSteepSlopeSelector, highCutSteepSlopeSelector;
+    std::unique_ptr<ComboBoxAttachment> lowCutSteepSlopeAttachment,
+        highCutSteepSlopeAttachment;
+
+    void updateCutControls();
+
     ResponseCurveComponent responseCurveComponent;
 
     // * Bypass buttons
@@ -355,8 +388,8 @@ private:
     AnalyzerButton analyzerEnabledButton;
 
     using ButtonAttachment = APVTS::ButtonAttachment;
+    std::unique_ptr<ButtonAttachment> peakBypassButtonAttachment;
     ButtonAttachment lowcutBypassButtonAttachment,
-        peakBypassButtonAttachment,
         highcutBypassButtonAttachment,
         analyzerEnabledButtonAttachment;
 
@@ -0,0 +1,517 @@
+/*
+  ==============================================================================
+
+    PluginParameters.h
+    Created: 16 Oct 2026 5:02:44pm
+    Author:  brccabral
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginUtilities.h"
+
+// * the parameters of one band of the peak bank
+enum PeakBandParameter
+{
+    PeakBand_Freq,
+    PeakBand_Gain,
+    PeakBand_Quality,
+    PeakBand_Type,
+    PeakBand_Bypassed,
+    NumPeakBandParameters
+};
+
+// * every parameter, in the order of parameterDescriptors
+// * the binary state stores values in this order, only ever append to it
+enum ParameterIndex
+{
+    Parameter_LowCutFreq,
+    Parameter_HighCutFreq,
+    Parameter_PeakFreq,
+    Parameter_PeakGain,
+    Parameter_PeakQuality,
+    Parameter_LowCutSlope,
+    Parameter_HighCutSlope,
+    Parameter_LowCutBypassed,
+    Parameter_PeakBypassed,
+    Parameter_HighCutBypassed,
+    Parameter_AnalyzerEnabled,
+    Parameter_ProcessingMode,
+    Parameter_Oversampling,
+    Parameter_ModulationTarget,
+    Parameter_ModulationRate,
+    Parameter_ModulationDepth,
+    Parameter_FilterStructure,
+    Parameter_PeakDesign,
+    Parameter_StereoMode,
+    Parameter_LowCutChannels,
+    Parameter_PeakChannels,
+    Parameter_HighCutChannels,
+    Parameter_PeakType,
+    Parameter_NumPeakBands,
+    // * the bands of the bank after the first, NumPeakBandParameters each, see getPeakBandParameter()
+    Parameter_FirstExtraBand,
+    // * the parameters added after the bank
+    Parameter_LowCutSteepSlope = Parameter_FirstExtraBand + (MaxPeakBands - 1) * NumPeakBandParameters,
+    Parameter_HighCutSteepSlope,
+    NumParameters
+};
+
+// * the first band is the Peak the plugin always had, the others follow the fixed parameters
+constexpr ParameterIndex getPeakBandParameter(int band, PeakBandParameter parameter) noexcept
+{
+    if (band == 0)
+    {
+        constexpr ParameterIndex firstBand[] = {Parameter_PeakFreq, Parameter_PeakGain, Parameter_PeakQuality, Parameter_PeakType, Parameter_PeakBypassed};
+        return firstBand[parameter];
+    }
+
+    return (ParameterIndex)(Parameter_FirstExtraBand + (band - 1) * NumPeakBandParameters + parameter);
+}
+
+enum ParameterKind
+{
+    FloatParameter,
+    IntParameter,
+    ChoiceParameter,
+    BoolParameter
+};
+
+// * everything needed to create one parameter
+struct ParameterDescriptor
+{
+    ParameterIndex index;
+    const char *id;
+    ParameterKind kind;
+
+    // * skew - how linear is the parameter, 0 to 1 (percentage)
+    float minValue{0.f}, maxValue{1.f}, interval{0.f}, skew{1.f};
+
+    // * the value, the choice index or 0/1
+    float defaultValue{0.f};
+
+    const char *const *choices{nullptr};
+    int numChoices{0};
+};
+
+// * 4 options - 12, 24, 36, 48
+inline constexpr const char *slopeChoices[] = {"12 db/Oct", "24 db/Oct", "36 db/Oct", "48 db/Oct"};
+// * the slopes past 48, a choice of their own so automation written for the one above keeps its meaning
+inline constexpr const char *steepSlopeChoices[] = {"Off", "60 db/Oct", "72 db/Oct", "84 db/Oct", "96 db/Oct"};
+static_assert(std::size(slopeChoices) + std::size(steepSlopeChoices) - 1 == MaxCutSections, "one slope choice per cut section");
+inline constexpr const char *processingModeChoices[] = {"Minimum Phase", "Linear Phase"};
+inline constexpr const char *oversamplingChoices[] = {"Off", "2x", "4x"};
+inline constexpr const char *modulationTargetChoices[] = {"Peak", "Low Cut", "High Cut", "All Bands"};
+inline constexpr const char *filterStructureChoices[] = {"Biquad", "State Variable", "Parallel"};
+inline constexpr const char *peakDesignChoices[] = {"Bilinear", "Analog Matched"};
+inline constexpr const char *stereoModeChoices[] = {"Left/Right", "Mid/Side"};
+inline constexpr const char *bandChannelsChoices[] = {"Both", "Mid", "Side"};
+inline constexpr const char *peakTypeChoices[] = {"Peak", "Low Shelf", "High Shelf", "Notch"};
+
+// * every parameter up to the extra bands of the bank, those are made from the first band below
+inline constexpr ParameterDescriptor fixedParameterDescriptors[] = {
+    // * low freq filter, min-max 20Hz to 20kHz, default 20Hz
+    {Parameter_LowCutFreq, "LowCut Freq", FloatParameter, 20.f, 20000.f, 1.f, 0.25f, 20.f},
+    // * high freq filter, min-max 20Hz to 20kHz, default 20kHz
+    {Parameter_HighCutFreq, "HighCut Freq", FloatParameter, 20.f, 20000.f, 1.f, 0.25f, 20000.f},
+    // * min-max 20Hz to 20kHz, default center frequency 750Hz
+    {Parameter_PeakFreq, "Peak Freq", FloatParameter, 20.f, 20000.f, 1.f, 0.25f, 750.f},
+    // * min-max -24dB to 24dB, steps of 0.5dB, default gain 0.0f
+    {Parameter_PeakGain, "Peak Gain", FloatParameter, -24.f, 24.f, 0.5f, 1.f, 0.f},
+    // * how narrow or wide is the gain
+    {Parameter_PeakQuality, "Peak Quality", FloatParameter, 0.1f, 10.f, 0.05f, 1.f, 1.f},
+    // * default 0 = slopeChoices[0] = 12
+    {Parameter_LowCutSlope, "LowCut Slope", ChoiceParameter, 0.f, 0.f, 0.f, 1.f, 0.f, slopeChoices, (int)std::size(slopeChoices)},
+    {Parameter_HighCutSlope, "HighCut Slope", ChoiceParameter, 0.f, 0.f, 0.f, 1.f, 0.f, slopeChoices, (int)std::size(slopeChoices)},
+    {Parameter_LowCutBypassed, "LowCut Bypassed", BoolParameter},
+    {Parameter_PeakBypassed, "Peak Bypassed", BoolParameter},
+    {Parameter_HighCutBypassed, "HighCut Bypassed", BoolParameter},
+    {Parameter_AnalyzerEnabled, "Analyzer Enabled", BoolParameter, 0.f, 1.f, 0.f, 1.f, 1.f},
+    // * minimum phase biquads or a linear phase FIR with the same magnitude response
+    {Parameter_ProcessingMode, "Processing Mode", ChoiceParameter, 0.f, 0.f, 0.f, 1.f, 0.f, processingModeChoices, (int)std::size(processingModeChoices)},
+    // * runs the minimum phase chain at a higher rate, keeps the curves from cramping near Nyquist
+    {Parameter_Oversampling, "Oversampling", ChoiceParameter, 0.f, 0.f, 0.f, 1.f, 0.f, oversamplingChoices, (int)std::size(oversamplingChoices)},
+    // * an LFO sweeping the band frequencies, off while the depth is 0
+    {Parameter_ModulationTarget, "Mod Target", ChoiceParameter, 0.f, 0.f, 0.f, 1.f, 0.f, modulationTargetChoices, (int)std::size(modulationTargetChoices)},
+    // * min-max 0.05Hz to 20Hz, default 1Hz
+    {Parameter_ModulationRate, "Mod Rate", FloatParameter, 0.05f, 20.f, 0.01f, 0.3f, 1.f},
+    // * how far the frequency knobs are swept each way, 0 to 1 of their travel
+    // * above 0 on a band that is switched on, the chain runs as state variable filters, see Filter Structure
+    {Parameter_ModulationDepth, "Mod Depth", FloatParameter, 0.f, 1.f, 0.01f, 1.f, 0.f},
+    // * the same response from biquads, from state variable filters, which take fast sweeps and jumps better,
+    // * or from parallel sections, which don't wait on each other
+    // * overridden while the LFO sweeps a band: that always runs as state variable filters, a biquad swept every
+    // * sample overshoots, see makeChainCoefficients(); the choice comes back, crossfaded, once the depth is 0
+    {Parameter_FilterStructure, "Filter Structure", ChoiceParameter, 0.f, 0.f, 0.f, 1.f, 0.f, filterStructureChoices, (int)std::size(filterStructureChoices)},
+    // * the peak matched to its analog shape up to Nyquist, an alternative to oversampling for it
+    {Parameter_PeakDesign, "Peak Design", ChoiceParameter, 0.f, 0.f, 0.f, 1.f, 0.f, peakDesignChoices, (int)std::size(peakDesignChoices)},
+    // * a stereo pair filtered as mid and side, each band on both or on one of them
+    {Parameter_StereoMode, "Stereo Mode", ChoiceParameter, 0.f, 0.f, 0.f, 1.f, 0.f, stereoModeChoices, (int)std::size(stereoModeChoices)},
+    {Parameter_LowCutChannels, "LowCut Channels", ChoiceParameter, 0.f, 0.f, 0.f, 1.f, 0.f, bandChannelsChoices, (int)std::size(bandChannelsChoices)},
+    {Parameter_PeakChannels, "Peak Channels", ChoiceParameter, 0.f, 0.f, 0.f, 1.f, 0.f, bandChannelsChoices, (int)std::size(bandChannelsChoices)},
+    {Parameter_HighCutChannels, "HighCut Channels", ChoiceParameter, 0.f, 0.f, 0.f, 1.f, 0.f, bandChannelsChoices, (int)std::size(bandChannelsChoices)},
+    // * the shape of the first band, the Peak knobs set a shelf or a notch just as well
+    {Parameter_PeakType, "Peak Type", ChoiceParameter, 0.f, 0.f, 0.f, 1.f, 0.f, peakTypeChoices, (int)std::size(peakTypeChoices)},
+    // * how many bands of the bank run, the ones past it keep their settings
+    {Parameter_NumPeakBands, "Peak Bands", IntParameter, 1.f, (float)MaxPeakBands, 1.f, 1.f, 1.f},
+};
+
+static_assert(std::size(fixedParameterDescriptors) == Parameter_FirstExtraBand, "the extra bands come after the fixed parameters");
+
+// * every parameter after the extra bands of the bank
+inline constexpr ParameterDescriptor appendedParameterDescriptors[] = {
+    // * default Off, the Slope choice applies
+    {Parameter_LowCutSteepSlope, "LowCut Steep Slope", ChoiceParameter, 0.f, 0.f, 0.f, 1.f, 0.f, steepSlopeChoices, (int)std::size(steepSlopeChoices)},
+    {Parameter_HighCutSteepSlope, "HighCut Steep Slope", ChoiceParameter, 0.f, 0.f, 0.f, 1.f, 0.f, steepSlopeChoices, (int)std::size(steepSlopeChoices)},
+};
+
+static_assert(std::size(appendedParameterDescriptors) == NumParameters - Parameter_LowCutSteepSlope, "one descriptor per appended parameter");
+
+// * "Peak 2 Freq" to "Peak 16 Bypassed", written at compile time so the descriptors can point at them
+struct PeakBandParameterIDs
+{
+    static constexpr size_t MaxLength = 20;
+    char ids[MaxPeakBands - 1][NumPeakBandParameters][MaxLength];
+};
+
+constexpr void appendText(char *destination, size_t &length, const char *text) noexcept
+{
+    while (*text != 0)
+        destination[length++] = *text++;
+}
+
+constexpr PeakBandParameterIDs makePeakBandParameterIDs() noexcept
+{
+    constexpr const char *names[] = {" Freq", " Gain", " Quality", " Type", " Bypassed"};
+    static_assert(std::size(names) == NumPeakBandParameters, "one name per band parameter");
+
+    PeakBandParameterIDs result{};
+
+    for (int band = 1; band < MaxPeakBands; ++band)
+    {
+        for (int parameter = 0; parameter < NumPeakBandParameters; ++parameter)
+        {
+            auto *id = result.ids[band - 1][parameter];
+            size_t length = 0;
+
+            // * bands are numbered from 1, like the host shows them
+            appendText(id, length, "Peak ");
+
+            if (band + 1 >= 10)
+                id[length++] = '1';
+
+            id[length++] = (char)('0' + (band + 1) % 10);
+
+            appendText(id, length, names[parameter]);
+        }
+    }
+
+    return result;
+}
+
+inline constexpr auto peakBandParameterIDs = makePeakBandParameterIDs();
+
+// * the extra bands start spread over the spectrum, around the 750Hz of the first one
+inline constexpr float peakBandDefaultFrequencies[MaxPeakBands - 1] = {40.f, 63.f, 100.f, 160.f, 250.f, 400.f, 1000.f, 1600.f,
+                                                                       2500.f, 4000.f, 6300.f, 8000.f, 10000.f, 12500.f, 16000.f};
+
+// * the fixed parameters, a copy of the first band's for every other band of the bank, then the appended ones
+constexpr std::array<ParameterDescriptor, NumParameters> makeParameterDescriptors() noexcept
+{
+    std::array<ParameterDescriptor, NumParameters> descriptors{};
+
+    for (size_t i = 0; i < std::size(fixedParameterDescriptors); ++i)
+        descriptors[i] = fixedParameterDescriptors[i];
+
+    for (int band = 1; band < MaxPeakBands; ++band)
+    {
+        for (int parameter = 0; parameter < NumPeakBandParameters; ++parameter)
+        {
+            auto descriptor = fixedParameterDescriptors[getPeakBandParameter(0, (PeakBandParameter)parameter)];
+
+            descriptor.index = getPeakBandParameter(band, (PeakBandParameter)parameter);
+            descriptor.id = peakBandParameterIDs.ids[band - 1][parameter];
+
+            if (parameter == PeakBand_Freq)
+                descriptor.defaultValue = peakBandDefaultFrequencies[band - 1];
+
+            descriptors[(size_t)descriptor.index] = descriptor;
+        }
+    }
+
+    for (const auto &descriptor : appendedParameterDescriptors)
+        descriptors[(size_t)descriptor.index] = descriptor;
+
+    return descriptors;
+}
+
+// * the one place parameters are defined, the layout, the IDs and the value handles come from here
+inline constexpr std::array<ParameterDescriptor, NumParameters> parameterDescriptors = makeParameterDescriptors();
+
+constexpr bool areParameterDescriptorsInOrder() noexcept
+{
+    for (size_t i = 0; i < parameterDescriptors.size(); ++i)
+        if (parameterDescriptors[i].index != (ParameterIndex)i)
+            return false;
+
+    return true;
+}
+
+static_assert(areParameterDescriptorsInOrder(), "parameterDescriptors must follow ParameterIndex");
+
+constexpr const char *getParameterID(ParameterIndex index) noexcept
+{
+    return parameterDescriptors[(size_t)index].id;
+}
+
+constexpr bool haveSameRange(ParameterIndex a, ParameterIndex b) noexcept
+{
+    const auto &x = parameterDescriptors[(size_t)a];
+    const auto &y = parameterDescriptors[(size_t)b];
+    return x.minValue == y.minValue && x.maxValue == y.maxValue && x.skew == y.skew;
+}
+
+static_assert(haveSameRange(Parameter_PeakFreq, Parameter_LowCutFreq) && haveSameRange(Parameter_PeakFreq, Parameter_HighCutFreq),
+              "the frequency tables assume one range for every frequency parameter");
+
+// * the skewed range every frequency parameter uses, without the 1Hz steps
+inline juce::NormalisableRange<float> makeFrequencyRange()
+{
+    const auto &descriptor = parameterDescriptors[Parameter_PeakFreq];
+    return {descriptor.minValue, descriptor.maxValue, 0.f, descriptor.skew};
+}
+
+inline juce::AudioProcessorValueTreeState::ParameterLayout makeParameterLayout()
+{
+    juce::AudioProcessorValueTreeState::ParameterLayout layout;
+
+    for (const auto &descriptor : parameterDescriptors)
+    {
+        switch (descriptor.kind)
+        {
+        case FloatParameter:
+            layout.add(std::make_unique<juce::AudioParameterFloat>(descriptor.id,
+                                                                   descriptor.id,
+                                                                   juce::NormalisableRange<float>(descriptor.minValue,
+                                                                                                  descriptor.maxValue,
+                                                                                                  descriptor.interval,
+                                                                                                  descriptor.skew),
+                                                                   descriptor.defaultValue));
+            break;
+
+        case IntParameter:
+            layout.add(std::make_unique<juce::AudioParameterInt>(descriptor.id,
+                                                                 descriptor.id,
+                                                                 (int)descriptor.minValue,
+                                                                 (int)descriptor.maxValue,
+                                                                 (int)descriptor.defaultValue));
+            break;
+
+        case ChoiceParameter:
+            layout.add(std::make_unique<juce::AudioParameterChoice>(descriptor.id,
+                                                                    descriptor.id,
+                                                                    juce::StringArray(descriptor.choices, descriptor.numChoices),
+                                                                    (int)descriptor.defaultValue));
+            break;
+
+        case BoolParameter:
+            layout.add(std::make_unique<juce::AudioParameterBool>(descriptor.id, descriptor.id, descriptor.defaultValue > 0.5f));
+            break;
+        }
+    }
+
+    return layout;
+}
+
+// * the raw value of every parameter, looked up by ID once
+// * reading them afterwards is an array index and an atomic load, no hashing or string compare
+struct ParameterHandles
+{
+    explicit ParameterHandles(juce::AudioProcessorValueTreeState &apvts)
+    {
+        for (const auto &descriptor : parameterDescriptors)
+        {
+            values[(size_t)descriptor.index] = apvts.getRawParameterValue(descriptor.id);
+            parameters[(size_t)descriptor.index] = apvts.getParameter(descriptor.id);
+            jassert(values[(size_t)descriptor.index] != nullptr && parameters[(size_t)descriptor.index] != nullptr);
+        }
+    }
+
+    float get(ParameterIndex index) const noexcept { return values[(size_t)index]->load(std::memory_order_relaxed); }
+
+    bool getBool(ParameterIndex index) const noexcept { return get(index) > 0.5f; }
+
+    template <typename EnumType>
+    EnumType getChoice(ParameterIndex index) const noexcept { return static_cast<EnumType>(juce::roundToInt(get(index))); }
+
+    // * the handles don't change, the parameter does, and the host is told about it
+    // * an unchanged value is skipped, recalling a session doesn't flood the host with notifications
+    void set(ParameterIndex index, float value) const
+    {
+        auto *parameter = parameters[(size_t)index];
+        auto normalised = parameter->convertTo0to1(value);
+
+        if (normalised != parameter->getValue())
+            parameter->setValueNotifyingHost(normalised);
+    }
+
+private:
+    std::array<std::atomic<float> *, NumParameters> values{};
+    std::array<juce::RangedAudioParameter *, NumParameters> parameters{};
+};
+
+/*
+ Binary plugin state: a fixed header followed by one little endian float per parameter,
+ in ParameterIndex order. Saving and loading is a copy of a few dozen bytes instead of
+ building and parsing a ValueTree.
+ A state with fewer values (saved before parameters were appended) leaves the rest alone.
+ A chunk holding a value that isn't a finite number is corrupt and is ignored as a whole, values out
+ of a parameter's range (a hand edited chunk) are clamped to it, so the designer only ever sees
+ values the parameters can take.
+ */
+struct BinaryStateHeader
+{
+    // * the binary ValueTree format starts with the tree type name, "Parameters", so this can't clash
+    static constexpr juce::uint32 expectedMagic = 0x74535145; // * "EQSt"
+    static constexpr juce::uint16 currentVersion = 1;
+
+    juce::uint32 magic;
+    juce::uint16 version;
+    juce::uint16 numParameters;
+};
+
+static_assert(sizeof(BinaryStateHeader) == 8, "the header is stored as is, keep it packed");
+
+inline void writeBinaryState(const ParameterHandles &parameters, juce::MemoryBlock &destData)
+{
+    const BinaryStateHeader header{juce::ByteOrder::swapIfBigEndian(BinaryStateHeader::expectedMagic),
+                                   juce::ByteOrder::swapIfBigEndian(BinaryStateHeader::currentVersion),
+                                   juce::ByteOrder::swapIfBigEndian((juce::uint16)NumParameters)};
+
+    std::array<juce::uint32, NumParameters> values;
+
+    for (size_t i = 0; i < values.size(); ++i)
+    {
+        auto value = parameters.get((ParameterIndex)i);
+        std::memcpy(&values[i], &value, sizeof(value));
+        values[i] = juce::ByteOrder::swapIfBigEndian(values[i]);
+    }
+
+    destData.append(&header, sizeof(header));
+    destData.append(values.data(), sizeof(values));
+}
+
+// * the range a stored value is clamped to, the choice index or 0/1 for the other kinds
+constexpr float clampToParameterRange(const ParameterDescriptor &descriptor, float value) noexcept
+{
+    auto lowest = descriptor.minValue, highest = descriptor.maxValue;
+
+    if (descriptor.kind == ChoiceParameter || descriptor.kind == BoolParameter)
+    {
+        lowest = 0.f;
+        highest = descriptor.kind == ChoiceParameter ? (float)(descriptor.numChoices - 1) : 1.f;
+    }
+
+    return value < lowest ? lowest : (value > highest ? highest : value);
+}
+
+// * false if the data isn't in the binary format, then it is an older ValueTree state
+// * a corrupt binary chunk returns true without changing anything
+inline bool readBinaryState(const ParameterHandles &parameters, const void *data, int sizeInBytes)
+{
+    BinaryStateHeader header;
+
+    if (sizeInBytes < (int)sizeof(header))
+        return false;
+
+    std::memcpy(&header, data, sizeof(header));
+
+    if (juce::ByteOrder::swapIfBigEndian(header.magic) != BinaryStateHeader::expectedMagic)
+        return false;
+
+    // * a newer version may have moved things around, don't guess
+    if (juce::ByteOrder::swapIfBigEndian(header.version) > BinaryStateHeader::currentVersion)
+        return false;
+
+    const auto numStored = (size_t)juce::ByteOrder::swapIfBigEndian(header.numParameters);
+    const auto numValues = juce::jmin(numStored, (size_t)NumParameters);
+
+    if ((size_t)sizeInBytes < sizeof(header) + numStored * sizeof(juce::uint32))
+        return false;
+
+    std::array<juce::uint32, NumParameters> values;
+    std::memcpy(values.data(), static_cast<const char *>(data) + sizeof(header), numValues * sizeof(juce::uint32));
+
+    // * every value is checked before any is set, a corrupt chunk doesn't leave half a preset behind
+    std::array<float, NumParameters> decoded;
+
+    for (size_t i = 0; i < numValues; ++i)
+    {
+        auto bits = juce::ByteOrder::swapIfBigEndian(values[i]);
+        std::memcpy(&decoded[i], &bits, sizeof(float));
+
+        if (!std::isfinite(decoded[i]))
+        {
+            jassertfalse;
+            return true;
+        }
+    }
+
+    for (size_t i = 0; i < numValues; ++i)
+        parameters.set((ParameterIndex)i, clampToParameterRange(parameterDescriptors[i], decoded[i]));
+
+    return true;
+}
+
+// * a steep slope other than Off takes over from the 12 to 48 choice
+inline Slope getCutSlope(const ParameterHandles &parameters, ParameterIndex slope, ParameterIndex steepSlope) noexcept
+{
+    const auto steep = juce::roundToInt(parameters.get(steepSlope));
+    return steep > 0 ? (Slope)(Slope_48 + steep) : parameters.getChoice<Slope>(slope);
+}
+
+inline ChainSettings getChainSettings(const ParameterHandles &parameters)
+{
+    ChainSettings settings;
+
+    settings.lowCutFreq = parameters.get(Parameter_LowCutFreq);
+    settings.highCutFreq = parameters.get(Parameter_HighCutFreq);
+    settings.lowCutSlope = getCutSlope(parameters, Parameter_LowCutSlope, Parameter_LowCutSteepSlope);
+    settings.highCutSlope = getCutSlope(parameters, Parameter_HighCutSlope, Parameter_HighCutSteepSlope);
+
+    settings.lowCutBypassed = parameters.getBool(Parameter_LowCutBypassed);
+    settings.highCutBypassed = parameters.getBool(Parameter_HighCutBypassed);
+
+    const auto numPeakBands = juce::jlimit(1, MaxPeakBands, juce::roundToInt(parameters.get(Parameter_NumPeakBands)));
+
+    for (int band = 0; band < MaxPeakBands; ++band)
+    {
+        auto &peakBand = settings.peakBands[(size_t)band];
+
+        peakBand.freq = parameters.get(getPeakBandParameter(band, PeakBand_Freq));
+        peakBand.gainInDecibels = parameters.get(getPeakBandParameter(band, PeakBand_Gain));
+        peakBand.quality = parameters.get(getPeakBandParameter(band, PeakBand_Quality));
+        peakBand.type = parameters.getChoice<PeakBandType>(getPeakBandParameter(band, PeakBand_Type));
+        peakBand.bypassed = band >= numPeakBands || parameters.getBool(getPeakBandParameter(band, PeakBand_Bypassed));
+    }
+
+    settings.processingMode = parameters.getChoice<ProcessingMode>(Parameter_ProcessingMode);
+    settings.oversampling = parameters.getChoice<OversamplingFactor>(Parameter_Oversampling);
+
+    settings.modulationTarget = parameters.getChoice<ModulationTarget>(Parameter_ModulationTarget);
+    settings.modulationRate = parameters.get(Parameter_ModulationRate);
+    settings.modulationDepth = parameters.get(Parameter_ModulationDepth);
+
+    settings.filterStructure = parameters.getChoice<FilterStructure>(Parameter_FilterStructure);
+    settings.peakDesign = parameters.getChoice<PeakDesign>(Parameter_PeakDesign);
+
+    settings.stereoMode = parameters.getChoice<StereoMode>(Parameter_StereoMode);
+    settings.bandChannels = {parameters.getChoice<BandChannels>(Parameter_LowCutChannels),
+                             parameters.getChoice<BandChannels>(Parameter_PeakChannels),
+                             parameters.getChoice<BandChannels>(Parameter_HighCutChannels)};
+
+    return settings;
+}
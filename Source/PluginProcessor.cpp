@@ -22,10 +22,21 @@ AudioPlugin_JUCEAudioProcessor::AudioPlugin_JUCEAudioProcessor()
       )
 #endif
 {
+    for (auto *param : getParameters())
+        if (auto *paramWithID = dynamic_cast<juce::AudioProcessorParameterWithID *>(param))
+            apvts.addParameterListener(paramWithID->paramID, this);
+
+    designThread->addTimeSliceClient(this);
 }
 
 AudioPlugin_JUCEAudioProcessor::~AudioPlugin_JUCEAudioProcessor()
 {
+    // * waits for a running design to finish
+    designThread->removeTimeSliceClient(this);
+
+    for (auto *param : getParameters())
+        if (auto *paramWithID = dynamic_cast<juce::AudioProcessorParameterWithID *>(param))
+            apvts.removeParameterListener(paramWithID->paramID, this);
 }
 
 //==============================================================================
@@ -63,7 +74,8 @@ bool AudioPlugin_JUCEAudioProcessor::isMidiEffect() const
 
 double AudioPlugin_JUCEAudioProcessor::getTailLengthSeconds() const
 {
-    return 0.0;
+    // * from the pole radii of the designed chain, lets the host suspend us once it has rung out
+    return designedTailSeconds;
 }
 
 int AudioPlugin_JUCEAudioProcessor::getNumPrograms()
@@ -103,10 +115,65 @@ void AudioPlugin_JUCEAudioProcessor::prepareToPlay(double sampleRate, int sample
     // spec.numChannels = 1; // * mono chain
     spec.numChannels = getTotalNumOutputChannels();
 
-    leftChain.prepare(spec);
-    rightChain.prepare(spec);
+    hostSampleRate = sampleRate;
+
+    for (size_t factor = 0; factor < frequencyTables.size(); ++factor)
+        frequencyTables[factor].build(sampleRate * (1 << factor));
+
+    {
+        // * the designer thread uses the convolutions
+        const juce::ScopedLock lock(designLock);
+
+        // * juce::dsp::Convolution filters at most two channels, one runs per pair
+        auto pairSpec = spec;
+        pairSpec.numChannels = juce::jmin(2u, spec.numChannels);
+
+        convolutions.resize((size_t)juce::jmax(1, ((int)spec.numChannels + 1) / 2));
+
+        for (auto &convolution : convolutions)
+        {
+            if (convolution == nullptr)
+                convolution = std::make_unique<juce::dsp::Convolution>(juce::dsp::Convolution::Latency{0}, *convolutionQueue);
+
+            convolution->prepare(pairSpec);
+        }
+    }
+
+    // * only the precision the host picked is prepared, it is set before prepareToPlay()
+    if (isUsingDoublePrecision())
+    {
+        prepareProcessingPath<double>(spec);
+        floatBuffer.setSize((int)spec.numChannels, samplesPerBlock);
+    }
+    else
+    {
+        prepareProcessingPath<float>(spec);
+        floatBuffer.setSize(0, 0);
+    }
+
+    silentSamples = 0;
+    silenceTimeoutSamples = 0;
+    lastTailSamples = 0;
+
+    // * the audio thread is not running yet, design right away so the first block is correct
+    designSampleRate = sampleRate;
+    designNumChannels = (int)spec.numChannels;
+    ++parametersVersion;
+    designCoefficients();
+
+    ChainCoefficients chainCoefficients;
+    if (coefficientsExchange.pull(chainCoefficients))
+    {
+        // * force the rate and state setup for whatever was designed
+        oversampling = static_cast<OversamplingFactor>(-1);
+
+        if (isUsingDoublePrecision())
+            applyCoefficients<double>(chainCoefficients);
+        else
+            applyCoefficients<float>(chainCoefficients);
+    }
 
-    updateFilters();
+    setLatencySamples(designedLatency);
 
     leftChannelFifo.prepare(samplesPerBlock);
     rightChannelFifo.prepare(samplesPerBlock);
@@ -130,11 +197,10 @@ bool AudioPlugin_JUCEAudioProcessor::isBusesLayoutSupported(const BusesLayout &l
     juce::ignoreUnused(layouts);
     return true;
 #else
-    // This is the place where you check if the layout is supported.
-    // In this template code we only support mono or stereo.
-    // Some plugin hosts, such as certain GarageBand versions, will only
-    // load plugins that support stereo bus layouts.
-    if (layouts.getMainOutputChannelSet() != juce::AudioChannelSet::stereo())
+    // * any layout up to MaxChannels, surround and ambisonic included, the chains run every channel
+    // * with the same coefficients
+    const auto numChannels = layouts.getMainOutputChannelSet().size();
+    if (numChannels < 1 || numChannels > MaxChannels)
         return false;
 
         // This checks if the input layout matches the output layout
@@ -150,6 +216,27 @@ bool AudioPlugin_JUCEAudioProcessor::isBusesLayoutSupported(const BusesLayout &l
 
 void AudioPlugin_JUCEAudioProcessor::processBlock(juce::AudioBuffer<float> &buffer,
                                                   juce::MidiBuffer &midiMessages)
+{
+    processSamples(buffer);
+
+    leftChannelFifo.update(buffer);
+    rightChannelFifo.update(buffer);
+}
+
+void AudioPlugin_JUCEAudioProcessor::processBlock(juce::AudioBuffer<double> &buffer,
+                                                  juce::MidiBuffer &midiMessages)
+{
+    processSamples(buffer);
+
+    // * the analyzer works in float, the buffer was sized in prepareToPlay() so this doesn't allocate
+    floatBuffer.makeCopyOf(buffer, true);
+
+    leftChannelFifo.update(floatBuffer);
+    rightChannelFifo.update(floatBuffer);
+}
+
+template <typename SampleType>
+void AudioPlugin_JUCEAudioProcessor::processSamples(juce::AudioBuffer<SampleType> &buffer)
 {
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels = getTotalNumInputChannels();
@@ -164,10 +251,87 @@ void AudioPlugin_JUCEAudioProcessor::processBlock(juce::AudioBuffer<float> &buff
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear(i, 0, buffer.getNumSamples());
 
-    updateFilters();
+    // * not sample accurate: the JUCE wrappers hand us only the last automation point of each parameter,
+    // * without its sample offset, so the block can't be split at it
+    // * in realtime a new design comes from the designer thread, which polls every designerPollIntervalMs,
+    // * and starts at the first block after it, so up to 5 ms plus a block late
+    // * offline renders can run faster than the designer polls, design in place there, at most once per block
+    // * and only when a parameter moved, designCoefficients() checks that before taking its lock
+    if (isNonRealtime())
+        designCoefficients();
+
+    auto &path = getProcessingPath<SampleType>();
+    const auto numSamples = buffer.getNumSamples();
+
+    // * getMagnitude() is a SIMD min/max over every channel
+    const auto inputIsSilent = buffer.getMagnitude(0, numSamples) < (SampleType)SilenceThreshold;
+    const auto asleep = inputIsSilent && silentSamples >= silenceTimeoutSamples;
 
-    // * wrap the buffer into left/right blocks that can be used by the Chain process
-    juce::dsp::AudioBlock<float> block(buffer);
+    silentSamples = inputIsSilent ? juce::jmin(silentSamples + numSamples, silenceTimeoutSamples) : 0;
+
+    // * steady state: nothing new was designed, nothing to do
+    ChainCoefficients chainCoefficients;
+    if (coefficientsExchange.pull(chainCoefficients))
+    {
+        // * whatever state is left is below SilenceThreshold, start clean and skip the glide
+        if (asleep)
+            path.forEachChain([](auto &chain)
+                              { chain.reset(); });
+
+        applyCoefficients<SampleType>(chainCoefficients);
+    }
+
+    // * everything has rung out and nothing comes in: skip the whole path
+    // * the filter state is left as is, it is below SilenceThreshold so resuming doesn't click
+    if (asleep)
+    {
+        buffer.clear();
+        return;
+    }
+
+    // * oversampling and the FIR add latency, with nothing to filter they are swapped for a plain delay
+    if (processingMode == ProcessingMode::LinearPhase || oversampling != OversamplingFactor::Oversampling_Off)
+    {
+        // * only the minimum phase chain runs its glide out, in linear phase it never ends
+        const auto chainGliding = processingMode == ProcessingMode::MinimumPhase && path.isChainGliding();
+
+        if (!path.bypass.pushInput(buffer, bandsActive || chainGliding))
+        {
+            path.bypass.processOutput(buffer);
+            return;
+        }
+
+        // * the path was off, its state is from before that
+        if (path.bypass.isStartingUp())
+        {
+            for (auto &convolution : convolutions)
+                convolution->reset();
+
+            for (auto &oversampler : path.oversamplers)
+                oversampler->reset();
+        }
+    }
+
+    if (processingMode == ProcessingMode::LinearPhase)
+    {
+        // * the FIR isn't recursive, float is enough for it
+        if constexpr (std::is_same_v<SampleType, float>)
+        {
+            processConvolutions(juce::dsp::AudioBlock<float>(buffer));
+        }
+        else
+        {
+            floatBuffer.makeCopyOf(buffer, true);
+            processConvolutions(juce::dsp::AudioBlock<float>(floatBuffer));
+            buffer.makeCopyOf(floatBuffer, true);
+        }
+
+        path.bypass.processOutput(buffer);
+        return;
+    }
+
+    // * wrap the buffer into a block that can be used by the Chain process
+    juce::dsp::AudioBlock<SampleType> block(buffer);
 
     // buffer.clear();
     // juce::dsp::ProcessContextReplacing<float> stereoContext(block);
@@ -180,20 +344,22 @@ void AudioPlugin_JUCEAudioProcessor::processBlock(juce::AudioBuffer<float> &buff
     // }
     // osc.process(stereoContext);
 
-    auto leftBlock = block.getSingleChannelBlock(0);
-    auto rightBlock = block.getSingleChannelBlock(1);
+    juce::dsp::ProcessContextReplacing<SampleType> context(block);
 
-    juce::dsp::ProcessContextReplacing<float> leftContext(leftBlock);
-    juce::dsp::ProcessContextReplacing<float> rightContext(rightBlock);
-
-    leftChain.process(leftContext);
-    rightChain.process(rightContext);
+    if (oversampling != OversamplingFactor::Oversampling_Off)
+    {
+        auto &oversampler = *path.oversamplers[(size_t)oversampling];
 
-    leftChain.process(leftContext);
-    rightChain.process(rightContext);
+        auto oversampledBlock = oversampler.processSamplesUp(context.getInputBlock());
+        path.processChain(oversampledBlock);
+        oversampler.processSamplesDown(context.getOutputBlock());
 
-    leftChannelFifo.update(buffer);
-    rightChannelFifo.update(buffer);
+        path.bypass.processOutput(buffer);
+    }
+    else
+    {
+        path.processChain(block);
+    }
 }
 
 //==============================================================================
@@ -214,8 +380,8 @@ void AudioPlugin_JUCEAudioProcessor::getStateInformation(juce::MemoryBlock &dest
     // You could do that either as raw data, or use the XML or ValueTree classes
     // as intermediaries to make it easy to save and load complex data.
 
-    juce::MemoryOutputStream mos(destData, true);
-    apvts.state.writeToStream(mos);
+    // * a fixed layout chunk of the parameter values, see PluginParameters.h
+    writeBinaryState(parameterHandles, destData);
 }
 
 void AudioPlugin_JUCEAudioProcessor::setStateInformation(const void *data, int sizeInBytes)
@@ -223,12 +389,20 @@ void AudioPlugin_JUCEAudioProcessor::setStateInformation(const void *data, int s
     // You should use this method to restore your parameters from this memory block,
     // whose contents will have been created by the getStateInformation() call.
 
-    auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
-    if (tree.isValid())
+    // * the parameters notify parameterChanged(), the designer picks the new values up from there
+    // * the sequence is odd while the parameters are half old and half new, the designer waits for it to be even
+    stateSequence.fetch_add(1, std::memory_order_acq_rel);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (!readBinaryState(parameterHandles, data, sizeInBytes))
     {
-        apvts.replaceState(tree);
-        updateFilters();
+        // * sessions saved before the binary format hold the whole ValueTree
+        auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
+        if (tree.isValid())
+            apvts.replaceState(tree);
     }
+
+    stateSequence.fetch_add(1, std::memory_order_release);
 }
 
 //==============================================================================
@@ -241,108 +415,241 @@ juce::AudioProcessor *JUCE_CALLTYPE createPluginFilter()
 // * configure parameters to send to our nobs/filters "Low Cut", "High Cut" and "Peak"
 juce::AudioProcessorValueTreeState::ParameterLayout AudioPlugin_JUCEAudioProcessor::createParameterLayout()
 {
-    juce::AudioProcessorValueTreeState::ParameterLayout layout;
-
-    // * skew - how linear is the parameter, 0 to 1 (percentage)
-
-    // * low freq filter, min-max 20Hz to 20kHz, default 20Hz
-    layout.add(std::make_unique<juce::AudioParameterFloat>("LowCut Freq",
-                                                           "LowCut Freq",
-                                                           juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
-                                                           20.f));
-
-    // * high freq filter, min-max 20Hz to 20kHz, default 20kHz
-    layout.add(std::make_unique<juce::AudioParameterFloat>("HighCut Freq",
-                                                           "HighCut Freq",
-                                                           juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
-                                                           20000.f));
-
-    // * min-max 20Hz to 20kHz, default center frequency 750Hz
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Peak Freq",
-                                                           "Peak Freq",
-                                                           juce::NormalisableRange<float>(20.f, 20000.f, 1.f, 0.25f),
-                                                           750.f));
-
-    // * min-max -24dB to 24dB, steps of 0.5dB, default gain 0.0f
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Peak Gain",
-                                                           "Peak Gain",
-                                                           juce::NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f),
-                                                           0.0f));
-
-    // * how narrow or wide is the gain
-    layout.add(std::make_unique<juce::AudioParameterFloat>("Peak Quality",
-                                                           "Peak Quality",
-                                                           juce::NormalisableRange<float>(0.1f, 10.f, 0.05f, 1.f),
-                                                           1.f));
-
-    // * 4 options - 12, 24, 36, 48
-    juce::StringArray stringArray;
-    for (int i = 0; i < 4; ++i)
+    // * generated from parameterDescriptors, see PluginParameters.h
+    return makeParameterLayout();
+}
+
+void AudioPlugin_JUCEAudioProcessor::parameterChanged(const juce::String &parameterID, float newValue)
+{
+    juce::ignoreUnused(parameterID, newValue);
+
+    ++parametersVersion;
+}
+
+int AudioPlugin_JUCEAudioProcessor::useTimeSlice()
+{
+    designCoefficients();
+
+    return designerPollIntervalMs;
+}
+
+void AudioPlugin_JUCEAudioProcessor::designCoefficients()
+{
+    // * steady state, the common case for every offline block: no lock, no allocation, no FIR
+    if (parametersVersion.load() == designedVersion.load(std::memory_order_relaxed))
+        return;
+
+    const juce::ScopedLock lock(designLock);
+
+    // * a state is being restored, design once it is complete instead of from a mix of two presets
+    auto sequence = stateSequence.load(std::memory_order_acquire);
+    if ((sequence & 1) != 0)
+        return;
+
+    // * read the version before the parameters, a change while reading triggers another design
+    auto version = parametersVersion.load();
+    auto sampleRate = designSampleRate.load();
+
+    if (version == designedVersion.load(std::memory_order_relaxed) || sampleRate <= 0)
+        return;
+
+    auto chainSettings = getChainSettings(parameterHandles);
+
+    // * a restore started while reading, the next poll reads the whole new state
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (stateSequence.load(std::memory_order_relaxed) != sequence)
+        return;
+
+    // * the biquads are designed for the rate they run at, the FIR always runs at the host rate
+    if (chainSettings.processingMode == ProcessingMode::LinearPhase)
+        chainSettings.oversampling = OversamplingFactor::Oversampling_Off;
+
+    // * mid and side only exist for a stereo pair
+    if (designNumChannels.load() != 2)
+        chainSettings.stereoMode = StereoMode_LeftRight;
+
+    auto chainCoefficients = makeChainCoefficients(chainSettings, sampleRate * (1 << chainSettings.oversampling));
+
+    // * the FIR is swapped in the background, juce::dsp::Convolution crossfades the old and new kernels
+    if (chainCoefficients.processingMode == ProcessingMode::LinearPhase)
     {
-        juce::String str;
-        str << (12 + i * 12);
-        str << " db/Oct";
-        stringArray.add(str);
+        // * a stereo pair is always matrixed around the FIR, switching the stereo mode or a placement only
+        // * loads another kernel, which is crossfaded like any other
+        const auto stereo = designNumChannels.load() == 2;
+        const auto kernel = makeLinearPhaseKernel(chainCoefficients, sampleRate, stereo ? 2 : 1);
+
+        for (auto &convolution : convolutions)
+            convolution->loadImpulseResponse(juce::AudioBuffer<float>(kernel),
+                                             sampleRate,
+                                             stereo ? juce::dsp::Convolution::Stereo::yes : juce::dsp::Convolution::Stereo::no,
+                                             juce::dsp::Convolution::Trim::no,
+                                             juce::dsp::Convolution::Normalise::no);
     }
 
-    // * default 0 = stringArray[0] = 12
-    layout.add(std::make_unique<juce::AudioParameterChoice>("LowCut Slope", "LowCut Slope", stringArray, 0));
-    layout.add(std::make_unique<juce::AudioParameterChoice>("HighCut Slope", "HighCut Slope", stringArray, 0));
+    coefficientsExchange.push(chainCoefficients);
+    designedVersion.store(version, std::memory_order_relaxed);
 
-    layout.add(std::make_unique<juce::AudioParameterBool>("LowCut Bypassed", "LowCut Bypassed", false));
-    layout.add(std::make_unique<juce::AudioParameterBool>("Peak Bypassed", "Peak Bypassed", false));
-    layout.add(std::make_unique<juce::AudioParameterBool>("HighCut Bypassed", "HighCut Bypassed", false));
-    layout.add(std::make_unique<juce::AudioParameterBool>("Analyzer Enabled", "Analyzer Enabled", true));
+    designedTailSeconds = chainCoefficients.tailSeconds;
 
-    return layout;
+    auto latency = getLatency(chainCoefficients);
+    if (designedLatency.exchange(latency) != latency)
+        triggerAsyncUpdate();
 }
 
-void AudioPlugin_JUCEAudioProcessor::updatePeakFilter(const ChainSettings &chainSettings)
+template <typename SampleType>
+void AudioPlugin_JUCEAudioProcessor::prepareProcessingPath(const juce::dsp::ProcessSpec &spec)
 {
-    auto peakCoefficients = makePeakFilter(chainSettings, getSampleRate());
+    auto &path = getProcessingPath<SampleType>();
+
+    {
+        // * the designer thread uses the oversampling latencies
+        const juce::ScopedLock lock(designLock);
+
+        for (int factor = 0; factor < NumOversamplingFactors; ++factor)
+        {
+            auto &oversampler = path.oversamplers[(size_t)factor];
+
+            oversampler = std::make_unique<juce::dsp::Oversampling<SampleType>>(spec.numChannels,
+                                                                                (size_t)factor,
+                                                                                juce::dsp::Oversampling<SampleType>::filterHalfBandPolyphaseIIR,
+                                                                                true,
+                                                                                true);
+            oversampler->initProcessing((size_t)spec.maximumBlockSize);
+            oversamplingLatencies[(size_t)factor] = juce::roundToInt(oversampler->getLatencyInSamples());
+        }
+    }
 
-    leftChain.setBypassed<ChainPositions::Peak>(chainSettings.peakBypassed);
-    rightChain.setBypassed<ChainPositions::Peak>(chainSettings.peakBypassed);
+    // * long enough for the FIR and for any of the oversamplers
+    auto maxLatency = getLinearPhaseKernelLength(spec.sampleRate) / 2 + convolutions.front()->getLatency();
+    for (auto latency : oversamplingLatencies)
+        maxLatency = juce::jmax(maxLatency, latency);
 
-    updateCoefficients(leftChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
-    updateCoefficients(rightChain.get<ChainPositions::Peak>().coefficients, peakCoefficients);
+    path.bypass.prepare((int)spec.numChannels, (int)spec.maximumBlockSize, maxLatency);
+    path.bypass.setFadeLength(juce::roundToInt(spec.sampleRate * bypassFadeSeconds));
+
+    // * the chain is prepared for the highest rate it can run at
+    auto oversampledSpec = spec;
+    oversampledSpec.sampleRate = spec.sampleRate * (1 << (NumOversamplingFactors - 1));
+    oversampledSpec.maximumBlockSize = spec.maximumBlockSize << (NumOversamplingFactors - 1);
+
+    auto prepareChain = [&](auto &chain)
+    {
+        chain.setGlideTime(smoothingTimeSeconds);
+        chain.prepare(oversampledSpec);
+    };
+
+    path.forEachChain(prepareChain);
+
+    path.handoverBuffer.setSize((int)spec.numChannels, (int)oversampledSpec.maximumBlockSize);
+    path.handoverGains.resize((size_t)oversampledSpec.maximumBlockSize);
+    path.setStructure(path.structure);
 }
 
-void AudioPlugin_JUCEAudioProcessor::updateLowCutFilters(const ChainSettings &chainSettings)
+template <typename SampleType>
+void AudioPlugin_JUCEAudioProcessor::applyCoefficients(const ChainCoefficients &chainCoefficients)
 {
-    auto lowCutCoefficients = makeLowCutFilter(chainSettings, getSampleRate());
+    auto &path = getProcessingPath<SampleType>();
+
+    // * the path we switch to has stale state, start it clean
+    if (chainCoefficients.processingMode != processingMode
+        || chainCoefficients.oversampling != oversampling)
+    {
+        processingMode = chainCoefficients.processingMode;
+        oversampling = chainCoefficients.oversampling;
 
-    auto &leftLowCut = leftChain.get<ChainPositions::LowCut>();
-    auto &rightLowCut = rightChain.get<ChainPositions::LowCut>();
+        auto factor = 1 << oversampling;
 
-    leftChain.setBypassed<ChainPositions::LowCut>(chainSettings.lowCutBypassed);
-    rightChain.setBypassed<ChainPositions::LowCut>(chainSettings.lowCutBypassed);
+        auto setUpChain = [&](auto &chain)
+        {
+            chain.reset();
+            chain.setSampleRate(hostSampleRate * factor);
+            chain.setControlInterval(smoothingControlInterval * factor);
+            chain.setFrequencyTable(&frequencyTables[(size_t)oversampling]);
+        };
 
-    updateCutFilter(leftLowCut, lowCutCoefficients, chainSettings.lowCutSlope);
-    updateCutFilter(rightLowCut, lowCutCoefficients, chainSettings.lowCutSlope);
+        path.forEachChain(setUpChain);
+
+        for (auto &convolution : convolutions)
+            convolution->reset();
+
+        for (auto &oversampler : path.oversamplers)
+            oversampler->reset();
+
+        // * the dry signal is delayed like the path, which needs twice its latency to fill up
+        auto latency = getLatency(chainCoefficients);
+        path.bypass.setPath(latency, latency * 2);
+
+        path.setStructure(chainCoefficients.effectiveStructure);
+    }
+    else
+    {
+        // * the parallel form falls back to the biquads as a knob crosses what it can run, fade instead of resetting
+        path.handOver(chainCoefficients.effectiveStructure,
+                      juce::roundToInt(hostSampleRate * (1 << oversampling) * smoothingTimeSeconds));
+    }
+
+    path.setChainCoefficients(chainCoefficients);
+
+    bandsActive = false;
+    forEachActiveSection(chainCoefficients, [this](const BiquadCoeffs &, int)
+                         { bandsActive = true; });
+
+    // * the state left by the previous coefficients may ring longer than the new ones
+    auto tailSamples = juce::jmin(std::ceil(chainCoefficients.tailSeconds * hostSampleRate),
+                                  (double)(std::numeric_limits<int>::max() / 2));
+    tailSamples += getLatency(chainCoefficients);
+
+    silenceTimeoutSamples = juce::jmax((int)tailSamples, lastTailSamples);
+    lastTailSamples = (int)tailSamples;
 }
 
-void AudioPlugin_JUCEAudioProcessor::updateHighCutFilters(const ChainSettings &chainSettings)
+void AudioPlugin_JUCEAudioProcessor::processConvolutions(juce::dsp::AudioBlock<float> block) noexcept
 {
-    auto highCutCoefficients = makeHighCutFilter(chainSettings, getSampleRate());
+    const auto numChannels = (int)block.getNumChannels();
+    const auto numSamples = (int)block.getNumSamples();
+
+    // * the FIR runs inside juce::dsp::Convolution, so a stereo pair is matrixed around it instead of in its pass
+    // * mid and side are half the sum and difference, left and right the plain sum and difference of those
+    // * the kernel is the same for both in left/right, which makes the matrix transparent
+    auto matrix = [&](float scale)
+    {
+        auto *left = block.getChannelPointer(0);
+        auto *right = block.getChannelPointer(1);
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const auto a = left[i], b = right[i];
 
-    auto &leftHighCut = leftChain.get<ChainPositions::HighCut>();
-    auto &rightHighCut = rightChain.get<ChainPositions::HighCut>();
+            left[i] = (a + b) * scale;
+            right[i] = (a - b) * scale;
+        }
+    };
 
-    leftChain.setBypassed<ChainPositions::HighCut>(chainSettings.highCutBypassed);
-    rightChain.setBypassed<ChainPositions::HighCut>(chainSettings.highCutBypassed);
+    const auto encodeMidSide = numChannels == 2;
 
-    updateCutFilter(leftHighCut, highCutCoefficients, chainSettings.highCutSlope);
-    updateCutFilter(rightHighCut, highCutCoefficients, chainSettings.highCutSlope);
+    if (encodeMidSide)
+        matrix(0.5f);
+
+    for (int first = 0, pair = 0; first < numChannels && pair < (int)convolutions.size(); first += 2, ++pair)
+    {
+        auto pairBlock = block.getSubsetChannelBlock((size_t)first, (size_t)juce::jmin(2, numChannels - first));
+        convolutions[(size_t)pair]->process(juce::dsp::ProcessContextReplacing<float>(pairBlock));
+    }
+
+    if (encodeMidSide)
+        matrix(1.f);
 }
 
-void AudioPlugin_JUCEAudioProcessor::updateFilters()
+int AudioPlugin_JUCEAudioProcessor::getLatency(const ChainCoefficients &chainCoefficients) const
 {
-    // * update parameters before process audio
-    auto chainSettings = getChainSettings(apvts);
+    // * the linear phase kernel is centred, the output is delayed by half of it
+    if (chainCoefficients.processingMode == ProcessingMode::LinearPhase)
+        return getLinearPhaseKernelLength(designSampleRate) / 2 + convolutions.front()->getLatency();
 
-    updatePeakFilter(chainSettings);
+    return oversamplingLatencies[(size_t)chainCoefficients.oversampling];
+}
 
-    updateLowCutFilters(chainSettings);
-    updateHighCutFilters(chainSettings);
+void AudioPlugin_JUCEAudioProcessor::handleAsyncUpdate()
+{
+    setLatencySamples(designedLatency);
 }
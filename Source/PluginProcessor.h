@@ -10,11 +10,19 @@
 
 #include <JuceHeader.h>
 #include "PluginUtilities.h"
+#include "PluginParameters.h"
+#include "BiquadEngine.h"
+#include "SvfEngine.h"
+#include "ParallelEngine.h"
+#include "LatencyBypass.h"
 
 //==============================================================================
 /**
  */
-class AudioPlugin_JUCEAudioProcessor : public juce::AudioProcessor
+class AudioPlugin_JUCEAudioProcessor : public juce::AudioProcessor,
+                                       public juce::AudioProcessorValueTreeState::Listener,
+                                       public juce::TimeSliceClient,
+                                       private juce::AsyncUpdater
 #if JucePlugin_Enable_ARA
     ,
                                        public juce::AudioProcessorARAExtension
@@ -34,6 +42,10 @@ public:
 #endif
 
     void processBlock(juce::AudioBuffer<float> &, juce::MidiBuffer &) override;
+    void processBlock(juce::AudioBuffer<double> &, juce::MidiBuffer &) override;
+
+    // * the biquads run in double when the host asks for it, see ProcessingPath
+    bool supportsDoublePrecisionProcessing() const override { return true; }
 
     //==============================================================================
     juce::AudioProcessorEditor *createEditor() override;
@@ -62,20 +74,252 @@ public:
     static juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
     juce::AudioProcessorValueTreeState apvts{*this, nullptr, "Parameters", createParameterLayout()};
 
+    // * cached value handles, read without looking the IDs up again
+    const ParameterHandles parameterHandles{apvts};
+
     // * frequency spectrum
     using BlockType = juce::AudioBuffer<float>;
     SingleChannelSampleFifo<BlockType> leftChannelFifo{Channel::Left};
     SingleChannelSampleFifo<BlockType> rightChannelFifo{Channel::Right};
 
+    // * juce::AudioProcessorValueTreeState::Listener, may be called from any thread
+    void parameterChanged(const juce::String &parameterID, float newValue) override;
+
+    // * juce::TimeSliceClient, runs on the shared CoefficientDesignThread
+    int useTimeSlice() override;
+
 private:
-    MonoChain leftChain, rightChain;
+    // * the processing state, run in the precision the host picked
+    // * low cutoffs at high sample rates put the poles so close to 1 that float state and coefficients audibly quantize
+    template <typename SampleType>
+    struct ProcessingPath
+    {
+        // * left and right are filtered together, one channel per SIMD lane
+        MultiChannelChain<SampleType> chain;
+        // * the same bands as TPT state variable filters, the Filter Structure parameter picks one
+        MultiChannelSvfChain<SampleType> svfChain;
+        // * the chain as a sum of second order sections
+        MultiChannelParallelChain<SampleType> parallelChain;
+
+        // * polyphase IIR half-band oversamplers, all factors are kept prepared so switching doesn't allocate
+        std::array<std::unique_ptr<juce::dsp::Oversampling<SampleType>>, NumOversamplingFactors> oversamplers;
+
+        // * takes over from the oversamplers or the FIR when every band is bypassed
+        LatencyBypass<SampleType> bypass;
+
+        // * the chain in use, a change of structure hands over to the new chain instead of resetting the path:
+        // * it starts clean and runs unheard until its state has settled, then the output crossfades to it
+        // * the outgoing chain keeps its last coefficients until the fade is over
+        FilterStructure structure{FilterStructure::FilterStructure_Biquad};
+        FilterStructure outgoingStructure{FilterStructure::FilterStructure_Biquad};
+        double handoverGain = 1.0, handoverStep = 0.0;
+        int handoverWarmUp = 0;
+
+        // * the outgoing chain's output and the gains of a block, sized for the oversampled block
+        juce::AudioBuffer<SampleType> handoverBuffer;
+        std::vector<SampleType> handoverGains;
+
+        // * the chains have the same interface, setup goes to all of them, processing to the one in use
+        template <typename Function>
+        void forEachChain(Function &&function)
+        {
+            function(chain);
+            function(svfChain);
+            function(parallelChain);
+        }
+
+        template <typename Function>
+        void withChain(FilterStructure structure, Function &&function)
+        {
+            switch (structure)
+            {
+            case FilterStructure_StateVariable:
+                function(svfChain);
+                break;
+            case FilterStructure_Parallel:
+                function(parallelChain);
+                break;
+            default:
+                function(chain);
+                break;
+            }
+        }
+
+        bool isHandingOver() const noexcept { return handoverGain < 1.0; }
+
+        bool isChainGliding() noexcept
+        {
+            bool gliding = isHandingOver();
+            withChain(structure, [&](auto &c) { gliding = gliding || c.isGliding(); });
+            return gliding;
+        }
+
+        // * every chain was reset, switch without a fade
+        void setStructure(FilterStructure newStructure) noexcept
+        {
+            structure = newStructure;
+            handoverGain = 1.0;
+        }
+
+        void handOver(FilterStructure newStructure, int fadeLength) noexcept
+        {
+            if (newStructure == structure)
+                return;
+
+            // * back to the chain that is still fading out: its state is live, the fade turns around where it is
+            if (isHandingOver() && newStructure == outgoingStructure)
+            {
+                std::swap(structure, outgoingStructure);
+                handoverGain = 1.0 - handoverGain;
+                handoverWarmUp = 0;
+                return;
+            }
+
+            // * a third structure during a fade drops the quieter of the two chains
+            if (handoverGain >= 0.5)
+                outgoingStructure = structure;
+
+            structure = newStructure;
+            withChain(structure, [](auto &c) { c.reset(); });
+
+            handoverGain = 0.0;
+            handoverStep = 1.0 / juce::jmax(1, fadeLength);
+            handoverWarmUp = fadeLength;
+        }
+
+        void setChainCoefficients(const ChainCoefficients &chainCoefficients) noexcept
+        {
+            withChain(structure, [&](auto &c) { c.setCoefficients(chainCoefficients); });
+        }
+
+        void processChain(juce::dsp::AudioBlock<SampleType> block) noexcept
+        {
+            juce::dsp::ProcessContextReplacing<SampleType> context(block);
+
+            if (!isHandingOver())
+            {
+                withChain(structure, [&](auto &c) { c.process(context); });
+                return;
+            }
+
+            const auto numChannels = block.getNumChannels();
+            const auto numSamples = block.getNumSamples();
+
+            auto outgoingBlock = juce::dsp::AudioBlock<SampleType>(handoverBuffer)
+                                     .getSubsetChannelBlock(0, numChannels)
+                                     .getSubBlock(0, numSamples);
+            outgoingBlock.copyFrom(block);
+
+            withChain(outgoingStructure, [&](auto &c)
+                      { c.process(juce::dsp::ProcessContextReplacing<SampleType>(outgoingBlock)); });
+            withChain(structure, [&](auto &c) { c.process(context); });
+
+            for (size_t i = 0; i < numSamples; ++i)
+            {
+                if (handoverWarmUp > 0)
+                    --handoverWarmUp;
+                else
+                    handoverGain = juce::jmin(1.0, handoverGain + handoverStep);
+
+                handoverGains[i] = (SampleType)handoverGain;
+            }
+
+            for (size_t channel = 0; channel < numChannels; ++channel)
+            {
+                auto *output = block.getChannelPointer(channel);
+                const auto *outgoing = outgoingBlock.getChannelPointer(channel);
+
+                for (size_t i = 0; i < numSamples; ++i)
+                    output[i] = outgoing[i] + handoverGains[i] * (output[i] - outgoing[i]);
+            }
+        }
+    };
+
+    ProcessingPath<float> floatPath;
+    ProcessingPath<double> doublePath;
+
+    template <typename SampleType>
+    ProcessingPath<SampleType> &getProcessingPath() noexcept
+    {
+        if constexpr (std::is_same_v<SampleType, double>)
+            return doublePath;
+        else
+            return floatPath;
+    }
+
+    // * the FIR and the analyzer stay in float, a double buffer goes through here for them
+    juce::AudioBuffer<float> floatBuffer;
+
+    // * linear phase mode, the FIR is designed on the designer thread and crossfaded in by juce::dsp::Convolution
+    // * one per pair of channels, created in prepareToPlay()
+    juce::SharedResourcePointer<juce::dsp::ConvolutionMessageQueue> convolutionQueue;
+    std::vector<std::unique_ptr<juce::dsp::Convolution>> convolutions;
+    ProcessingMode processingMode{ProcessingMode::MinimumPhase};
+
+    // * false when every band is bypassed or designed as identity
+    bool bandsActive = true;
+
+    // * frequency modulation tables for every rate the chain can run at, rebuilt only when the host rate changes
+    std::array<FrequencyTable, NumOversamplingFactors> frequencyTables;
+
+    std::array<int, NumOversamplingFactors> oversamplingLatencies{};
+    OversamplingFactor oversampling{OversamplingFactor::Oversampling_Off};
+    double hostSampleRate = 44100.0;
+
+    // * latency of the last designed configuration, reported to the host from the message thread
+    std::atomic<int> designedLatency{0};
+    std::atomic<double> designedTailSeconds{0};
+
+    // * digital silence: the whole path is skipped once the input has been silent for longer than the tail
+    int silentSamples = 0;
+    int silenceTimeoutSamples = 0;
+    int lastTailSamples = 0;
+
+    // * bumped on every parameter change, coefficients are only designed when it moves
+    std::atomic<juce::uint32> parametersVersion{1};
+    std::atomic<juce::uint32> designedVersion{0};
+    std::atomic<double> designSampleRate{0};
+    std::atomic<int> designNumChannels{0};
+
+    // * seqlock around setStateInformation(), so a design never reads half of a preset
+    std::atomic<juce::uint32> stateSequence{0};
+
+    // * designed coefficients travel from the designer to the audio thread through here
+    LatestValueExchange<ChainCoefficients> coefficientsExchange;
+    juce::CriticalSection designLock;
+    juce::SharedResourcePointer<CoefficientDesignThread> designThread;
+
+    static constexpr int designerPollIntervalMs = 5;
+
+    // * parameter changes glide over smoothingTimeSeconds, coefficients move every smoothingControlInterval samples
+    static constexpr int smoothingControlInterval = 32;
+    static constexpr double smoothingTimeSeconds = 0.05;
+
+    // * crossfade between the latent path and its delay line
+    static constexpr double bypassFadeSeconds = 0.01;
+
+    // * widest bus accepted, 7th order ambisonics
+    static constexpr int MaxChannels = 64;
+
+    // * designs the current parameters if they changed since the last design
+    // * runs on the designer thread, and on the audio thread in offline renders, see processSamples(): there it
+    // * takes designLock, allocates and, in linear phase, builds the FIR and loads it into every convolution
+    void designCoefficients();
+
+    template <typename SampleType>
+    void prepareProcessingPath(const juce::dsp::ProcessSpec &spec);
+    template <typename SampleType>
+    void applyCoefficients(const ChainCoefficients &chainCoefficients);
+    template <typename SampleType>
+    void processSamples(juce::AudioBuffer<SampleType> &buffer);
 
-    void updatePeakFilter(const ChainSettings &chainSettings);
+    // * runs every channel pair of the block through its convolution, a mid/side pair is encoded around it
+    void processConvolutions(juce::dsp::AudioBlock<float> block) noexcept;
 
-    void updateLowCutFilters(const ChainSettings &chainSettings);
-    void updateHighCutFilters(const ChainSettings &chainSettings);
+    int getLatency(const ChainCoefficients &chainCoefficients) const;
 
-    void updateFilters();
+    // * juce::AsyncUpdater, reports the latency of a new configuration from the message thread
+    void handleAsyncUpdate() override;
 
     // juce::dsp::Oscillator<float> osc;
 
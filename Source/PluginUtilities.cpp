@@ -9,90 +9,557 @@
 */
 
 #include "PluginUtilities.h"
+#include "PluginParameters.h"
+#include "CoefficientCache.h"
 
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState &apvts)
+// * the same maths as IIR::Coefficients::makePeakFilter(), makeLowShelf(), makeHighShelf() and makeNotch(),
+// * without the reference counted allocation
+BiquadCoeffs makePeakFilter(const PeakBandSettings &band, double sampleRate)
 {
-    ChainSettings settings;
+    const auto A = std::sqrt(juce::Decibels::decibelsToGain((double)band.gainInDecibels));
+    const auto omega = juce::MathConstants<double>::twoPi * band.freq / sampleRate;
+    const auto alpha = std::sin(omega) / (band.quality * 2.0);
+    const auto cosOmega = std::cos(omega);
 
-    settings.lowCutFreq = apvts.getRawParameterValue("LowCut Freq")->load();
-    settings.highCutFreq = apvts.getRawParameterValue("HighCut Freq")->load();
-    settings.peakFreq = apvts.getRawParameterValue("Peak Freq")->load();
-    settings.peakGainInDecibels = apvts.getRawParameterValue("Peak Gain")->load();
-    settings.peakQuality = apvts.getRawParameterValue("Peak Quality")->load();
-    settings.lowCutSlope = static_cast<Slope>(apvts.getRawParameterValue("LowCut Slope")->load());
-    settings.highCutSlope = static_cast<Slope>(apvts.getRawParameterValue("HighCut Slope")->load());
+    switch (band.type)
+    {
+    case PeakBandType_LowShelf:
+    case PeakBandType_HighShelf:
+    {
+        // * the high shelf is the low shelf with cos(omega) and the odd coefficients negated
+        const auto sign = band.type == PeakBandType_LowShelf ? 1.0 : -1.0;
+        const auto c = sign * cosOmega;
+        const auto beta = 2.0 * std::sqrt(A) * alpha;
+        const auto aPlus = A + 1.0, aMinus = A - 1.0;
+        const auto a0 = aPlus + aMinus * c + beta;
+
+        return {A * (aPlus - aMinus * c + beta) / a0,
+                sign * 2.0 * A * (aMinus - aPlus * c) / a0,
+                A * (aPlus - aMinus * c - beta) / a0,
+                sign * -2.0 * (aMinus + aPlus * c) / a0,
+                (aPlus + aMinus * c - beta) / a0};
+    }
+
+    case PeakBandType_Notch:
+    {
+        const auto a0 = 1.0 + alpha;
+        const auto c2 = -2.0 * cosOmega / a0;
 
-    settings.lowCutBypassed = apvts.getRawParameterValue("LowCut Bypassed")->load() > 0.5f;
-    settings.peakBypassed = apvts.getRawParameterValue("Peak Bypassed")->load() > 0.5f;
-    settings.highCutBypassed = apvts.getRawParameterValue("HighCut Bypassed")->load() > 0.5f;
+        return {1.0 / a0, c2, 1.0 / a0, c2, (1.0 - alpha) / a0};
+    }
 
-    return settings;
+    default:
+    {
+        const auto c2 = -2.0 * cosOmega;
+        const auto a0 = 1.0 + alpha / A;
+
+        return {(1.0 + alpha * A) / a0, c2 / a0, (1.0 - alpha * A) / a0, c2 / a0, (1.0 - alpha / A) / a0};
+    }
+    }
 }
 
-// * coefficients are allocated on the Heap, we need to dereference
-// * we need to be free function because we will use it in the Editor.h
-void updateCoefficients(Coefficients &old, const Coefficients &replacements)
+// * M. Vicanek, "Matched Second Order Digital Filters" (2016), for the analog peak of makePeakFilter():
+// * H(s) = (s^2 + s A/Q + 1) / (s^2 + s/(A Q) + 1)
+// * the poles are the analog ones mapped by z = e^(sT), the zeros are solved so the digital magnitude
+// * matches the analog one at DC, at the centre frequency and in its curvature there
+BiquadCoeffs makeMatchedPeakFilter(const PeakBandSettings &band, double sampleRate)
 {
-    *old = *replacements;
+    jassert(band.type == PeakBandType_Peak);
+
+    const auto G = juce::Decibels::decibelsToGain((double)band.gainInDecibels);
+    const auto omega = juce::MathConstants<double>::twoPi * band.freq / sampleRate;
+    const auto zeta = 1.0 / (2.0 * band.quality * std::sqrt(G));
+
+    // * overdamped poles are real, cosh() takes the place of cos()
+    const auto decay = std::exp(-zeta * omega);
+    const auto a1 = zeta <= 1.0 ? -2.0 * decay * std::cos(std::sqrt(1.0 - zeta * zeta) * omega)
+                                : -2.0 * decay * std::cosh(std::sqrt(zeta * zeta - 1.0) * omega);
+    const auto a2 = decay * decay;
+
+    // * squared magnitudes are written as A0 phi0 + A1 phi1 + A2 phi2 with phi1 = sin^2(w / 2)
+    const auto A0 = (1.0 + a1 + a2) * (1.0 + a1 + a2);
+    const auto A1 = (1.0 - a1 + a2) * (1.0 - a1 + a2);
+    const auto A2 = -4.0 * a2;
+
+    const auto phi1 = std::pow(std::sin(omega * 0.5), 2.0);
+    const auto phi0 = 1.0 - phi1;
+    const auto phi2 = 4.0 * phi0 * phi1;
+
+    const auto R1 = (A0 * phi0 + A1 * phi1 + A2 * phi2) * G * G;
+    const auto R2 = (-A0 + A1 + 4.0 * (phi0 - phi1) * A2) * G * G;
+
+    const auto B0 = A0;
+    const auto B2 = (R1 - R2 * phi1 - B0) / (4.0 * phi1 * phi1);
+    const auto B1 = R2 + B0 + 4.0 * (phi1 - phi0) * B2;
+
+    // * rounding can take B1 or the discriminant a hair below 0
+    const auto sqrtB0 = std::sqrt(B0);
+    const auto sqrtB1 = std::sqrt(juce::jmax(0.0, B1));
+    const auto W = 0.5 * (sqrtB0 + sqrtB1);
+
+    const auto b0 = 0.5 * (W + std::sqrt(juce::jmax(0.0, W * W + B2)));
+    const auto b1 = 0.5 * (sqrtB0 - sqrtB1);
+    const auto b2 = -B2 / (4.0 * b0);
+
+    return {b0, b1, b2, a1, a2};
 }
 
-// * makePeakFilter() is a free function because we will use it in the Editor.h
-Coefficients makePeakFilter(const ChainSettings &chainSettings, double sampleRate)
+std::array<BiquadCoeffs, MaxCutSections> makeLowCutFilter(const ChainSettings &chainSettings, double sampleRate)
 {
-    return juce::dsp::IIR::Coefficients<float>::makePeakFilter(sampleRate,
-                                                               chainSettings.peakFreq,
-                                                               chainSettings.peakQuality,
-                                                               juce::Decibels::decibelsToGain(chainSettings.peakGainInDecibels));
+    return designButterworthHighPass<MaxCutSections>(chainSettings.lowCutFreq,
+                                                     sampleRate,
+                                                     chainSettings.lowCutSlope + 1);
 }
 
-juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> makeLowCutFilter(const ChainSettings &chainSettings, double sampleRate)
+std::array<BiquadCoeffs, MaxCutSections> makeHighCutFilter(const ChainSettings &chainSettings, double sampleRate)
 {
-    return juce::dsp::FilterDesign<float>::designIIRHighpassHighOrderButterworthMethod(
-        chainSettings.lowCutFreq,
-        sampleRate,
-        (chainSettings.lowCutFreq + 1) * 2);
+    return designButterworthLowPass<MaxCutSections>(chainSettings.highCutFreq,
+                                                    sampleRate,
+                                                    chainSettings.highCutSlope + 1);
 }
 
-juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> makeHighCutFilter(const ChainSettings &chainSettings, double sampleRate)
+ChainCoefficients makeChainCoefficients(const ChainSettings &chainSettings, double sampleRate)
 {
-    return juce::dsp::FilterDesign<float>::designIIRLowpassHighOrderButterworthMethod(
-        chainSettings.highCutFreq,
-        sampleRate,
-        (chainSettings.highCutFreq + 1) * 2);
+    ChainCoefficients chainCoefficients;
+
+    // * every instance and editor with the same settings designs the same bands, the cache designs each once
+    auto &cache = getSharedCoefficientCache();
+
+    // * the FIR is designed once per change, it can't follow a modulated frequency
+    auto isModulated = [&chainSettings](ModulationTarget target)
+    {
+        return chainSettings.processingMode == ProcessingMode::MinimumPhase && chainSettings.modulationDepth > 0
+               && (chainSettings.modulationTarget == target || chainSettings.modulationTarget == ModulationTarget_AllBands);
+    };
+
+    // * the LFO only sweeps the first band and only when it is a peak, with bilinear sections from the
+    // * FrequencyTable, a swept peak keeps that design so its shape doesn't change when the sweep starts
+    const auto &sweptBand = chainSettings.peakBands[0];
+    const auto isPeakModulated = isModulated(ModulationTarget_Peak) && sweptBand.type == PeakBandType_Peak;
+
+    // * the matched design is for the peak shape, shelves and notches stay bilinear
+    auto isMatched = [&](int index)
+    {
+        return chainSettings.peakDesign == PeakDesign_Matched && chainSettings.peakBands[(size_t)index].type == PeakBandType_Peak
+               && !(index == 0 && isPeakModulated);
+    };
+
+    auto getCoefficientBand = [&](int index)
+    {
+        switch (chainSettings.peakBands[(size_t)index].type)
+        {
+        case PeakBandType_LowShelf:
+            return CoefficientBand_LowShelf;
+        case PeakBandType_HighShelf:
+            return CoefficientBand_HighShelf;
+        case PeakBandType_Notch:
+            return CoefficientBand_Notch;
+        default:
+            return isMatched(index) ? CoefficientBand_MatchedPeak : CoefficientBand_Peak;
+        }
+    };
+
+    // * designed in double: low cutoffs at high rates put the poles too close to 1 for float math
+    for (int index = 0; index < MaxPeakBands; ++index)
+    {
+        const auto &settings = chainSettings.peakBands[(size_t)index];
+
+        // * a switched off band costs neither a design nor a section
+        if (settings.bypassed)
+        {
+            chainCoefficients.peakBypassed[(size_t)index] = true;
+            continue;
+        }
+
+        // * a notch doesn't depend on the gain, keep it out of the key so every gain finds the same design
+        const auto gainInDecibels = settings.type == PeakBandType_Notch ? 0.f : settings.gainInDecibels;
+
+        const auto peak = cache.getOrMake({getCoefficientBand(index), 0, settings.freq, settings.quality, gainInDecibels, sampleRate},
+                                          [&]
+                                          {
+                                              CachedBand band;
+                                              band.sections[0] = isMatched(index) ? makeMatchedPeakFilter(settings, sampleRate) : makePeakFilter(settings, sampleRate);
+                                              // * bands that don't audibly change the signal are left out of the processing plan, like a peak at 0 dB
+                                              band.isIdentity = isEffectivelyIdentity(band.sections[0], sampleRate);
+                                              return band;
+                                          });
+
+        chainCoefficients.peaks[(size_t)index] = peak.sections[0];
+
+        // * a peak or a shelf at 0 dB is flat at every frequency the LFO can take it to
+        chainCoefficients.peakBypassed[(size_t)index] = peak.isIdentity;
+    }
+
+    auto makeCutBand = [sampleRate](const std::array<BiquadCoeffs, MaxCutSections> &sections, Slope slope)
+    {
+        CachedBand band{sections, true};
+
+        for (int i = 0; i <= slope; ++i)
+            band.isIdentity = band.isIdentity && isEffectivelyIdentity(sections[(size_t)i], sampleRate);
+
+        return band;
+    };
+
+    const auto lowCut = cache.getOrMake({CoefficientBand_LowCut, chainSettings.lowCutSlope, chainSettings.lowCutFreq, 0.f, 0.f, sampleRate},
+                                        [&]
+                                        { return makeCutBand(makeLowCutFilter(chainSettings, sampleRate), chainSettings.lowCutSlope); });
+
+    const auto highCut = cache.getOrMake({CoefficientBand_HighCut, chainSettings.highCutSlope, chainSettings.highCutFreq, 0.f, 0.f, sampleRate},
+                                         [&]
+                                         { return makeCutBand(makeHighCutFilter(chainSettings, sampleRate), chainSettings.highCutSlope); });
+
+    chainCoefficients.lowCut = lowCut.sections;
+    chainCoefficients.highCut = highCut.sections;
+
+    chainCoefficients.lowCutSlope = chainSettings.lowCutSlope;
+    chainCoefficients.highCutSlope = chainSettings.highCutSlope;
+
+    // * a cut that is flat at its base frequency may not be once the LFO sweeps it
+    chainCoefficients.lowCutBypassed = chainSettings.lowCutBypassed || (lowCut.isIdentity && !isModulated(ModulationTarget_LowCut));
+    chainCoefficients.highCutBypassed = chainSettings.highCutBypassed || (highCut.isIdentity && !isModulated(ModulationTarget_HighCut));
+
+    chainCoefficients.processingMode = chainSettings.processingMode;
+    chainCoefficients.oversampling = chainSettings.oversampling;
+
+    const auto range = makeFrequencyRange();
+    auto &modulation = chainCoefficients.modulation;
+
+    modulation.rate = chainSettings.modulationRate;
+    modulation.positions = {range.convertTo0to1(chainSettings.lowCutFreq),
+                            range.convertTo0to1(sweptBand.freq),
+                            range.convertTo0to1(chainSettings.highCutFreq)};
+    modulation.depths = {isModulated(ModulationTarget_LowCut) && !chainCoefficients.lowCutBypassed ? chainSettings.modulationDepth : 0.0,
+                         isPeakModulated && !chainCoefficients.peakBypassed[0] ? chainSettings.modulationDepth : 0.0,
+                         isModulated(ModulationTarget_HighCut) && !chainCoefficients.highCutBypassed ? chainSettings.modulationDepth : 0.0};
+
+    chainCoefficients.filterStructure = chainSettings.filterStructure;
+    // * a direct form section whose coefficients move every sample overshoots: a +12 dB peak swept at Mod Rate 20
+    // * and Depth 1 peaked at +24 dB, the TPT state variable filter stayed within the +12 dB, so any modulated
+    // * chain runs as that, see the Filter Structure parameter
+    chainCoefficients.effectiveStructure = modulation.isActive() ? FilterStructure_StateVariable : chainSettings.filterStructure;
+
+    chainCoefficients.bandChannels = chainSettings.bandChannels;
+    chainCoefficients.midSide = chainSettings.stereoMode == StereoMode_MidSide;
+
+    const auto isPlaced = chainCoefficients.midSide
+                          && (chainSettings.bandChannels[LowCut] != BandChannels_Both
+                              || chainSettings.bandChannels[Peak] != BandChannels_Both
+                              || chainSettings.bandChannels[HighCut] != BandChannels_Both);
+
+    // * one std::tan() per band and a few divisions, cheap enough to do for every design
+    if (chainCoefficients.effectiveStructure == FilterStructure_StateVariable)
+    {
+        static constexpr auto qs = makeButterworthQs<MaxCutSections>();
+
+        auto getG = [sampleRate](float frequency)
+        { return std::tan(juce::MathConstants<double>::pi * frequency / sampleRate); };
+
+        const auto lowCutG = getG(chainSettings.lowCutFreq);
+        const auto highCutG = getG(chainSettings.highCutFreq);
+
+        for (size_t i = 0; i < MaxCutSections; ++i)
+        {
+            const auto lowCutQ = qs[(size_t)chainSettings.lowCutSlope][i];
+            const auto highCutQ = qs[(size_t)chainSettings.highCutSlope][i];
+
+            chainCoefficients.lowCutSvf[i] = (int)i <= chainSettings.lowCutSlope ? makeSvfHighPass(lowCutG, lowCutQ) : SvfParameters{lowCutG};
+            chainCoefficients.highCutSvf[i] = (int)i <= chainSettings.highCutSlope ? makeSvfLowPass(highCutG, highCutQ) : SvfParameters{highCutG};
+        }
+
+        // * the LFO sweeps g, so a bilinear peak is set from its own g, anything else comes from its biquad
+        for (int index = 0; index < MaxPeakBands; ++index)
+        {
+            const auto &settings = chainSettings.peakBands[(size_t)index];
+
+            if (chainCoefficients.peakBypassed[(size_t)index])
+                chainCoefficients.peakSvf[(size_t)index] = SvfParameters{};
+            else if (settings.type == PeakBandType_Peak && !isMatched(index))
+                chainCoefficients.peakSvf[(size_t)index] = makeSvfPeak(getG(settings.freq), settings.quality,
+                                                                       std::sqrt(juce::Decibels::decibelsToGain((double)settings.gainInDecibels)));
+            else
+                chainCoefficients.peakSvf[(size_t)index] = makeSvfFromBiquad(chainCoefficients.peaks[(size_t)index]);
+        }
+    }
+
+    // * the parallel form is designed for one chain for every channel, and it fails where poles nearly
+    // * coincide, these cases run the biquads instead
+    if (chainCoefficients.effectiveStructure == FilterStructure_Parallel)
+    {
+        static constexpr double maxParallelError = 1.0e-3;
+
+        chainCoefficients.parallel = makeParallelCoefficients(chainCoefficients, sampleRate);
+
+        if (isPlaced || chainCoefficients.parallel.error > maxParallelError)
+            chainCoefficients.effectiveStructure = FilterStructure_Biquad;
+    }
+
+    chainCoefficients.tailSeconds = getTailLengthSeconds(chainCoefficients, sampleRate);
+
+    // * the poles move with the frequency, a band rings longest at the bottom of its sweep
+    if (modulation.isActive())
+    {
+        auto lowest = chainSettings;
+        auto getLowest = [&](ChainPositions band)
+        { return range.convertFrom0to1((float)juce::jmax(0.0, modulation.positions[band] - modulation.depths[band])); };
+
+        lowest.lowCutFreq = getLowest(LowCut);
+        lowest.peakBands[0].freq = getLowest(Peak);
+        lowest.highCutFreq = getLowest(HighCut);
+
+        auto swept = chainCoefficients;
+        swept.lowCut = makeLowCutFilter(lowest, sampleRate);
+        swept.peaks[0] = makePeakFilter(lowest.peakBands[0], sampleRate);
+        swept.highCut = makeHighCutFilter(lowest, sampleRate);
+
+        chainCoefficients.tailSeconds = juce::jmax(chainCoefficients.tailSeconds, getTailLengthSeconds(swept, sampleRate));
+    }
+
+    return chainCoefficients;
 }
 
-// * we need to be free function because we will use it in the Editor.h
-void updateCutFilter(CutFilter &lowCut,
-                     const juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> &cutCoefficients,
-                     const Slope &slope)
+std::complex<double> getResponseForFrequency(const BiquadCoeffs &coefficients, double frequency, double sampleRate)
 {
-    lowCut.template setBypassed<0>(true);
-    lowCut.template setBypassed<1>(true);
-    lowCut.template setBypassed<2>(true);
-    lowCut.template setBypassed<3>(true);
+    // * H(e^jw) = (b0 + b1 z^-1 + b2 z^-2) / (1 + a1 z^-1 + a2 z^-2)
+    const auto z = std::polar(1.0, -juce::MathConstants<double>::twoPi * frequency / sampleRate);
 
-    // * leaverage switch pass-through to get all necessary case statements
-    switch (slope)
-    {
-    case Slope_48:
+    const auto numerator = coefficients.b0 + z * (coefficients.b1 + z * coefficients.b2);
+    const auto denominator = 1.0 + z * (coefficients.a1 + z * coefficients.a2);
+
+    return numerator / denominator;
+}
+
+double getMagnitudeForFrequency(const BiquadCoeffs &coefficients, double frequency, double sampleRate)
+{
+    return std::abs(getResponseForFrequency(coefficients, frequency, sampleRate));
+}
+
+double getMagnitudeForFrequency(const ChainCoefficients &chainCoefficients, double frequency, double sampleRate)
+{
+    double mag = 1.0;
+
+    forEachActiveSection(chainCoefficients, [&](const BiquadCoeffs &coefficients, int)
+                         { mag *= getMagnitudeForFrequency(coefficients, frequency, sampleRate); });
+
+    return mag;
+}
+
+ChainCoefficients getMidSideChain(const ChainCoefficients &chainCoefficients, int midSideChannel)
+{
+    auto chain = chainCoefficients;
+
+    chain.lowCutBypassed = chain.lowCutBypassed || !doesBandReach(chain.bandChannels[LowCut], midSideChannel);
+    // * the Peak placement is for the whole bank
+    for (auto &peakBypassed : chain.peakBypassed)
+        peakBypassed = peakBypassed || !doesBandReach(chain.bandChannels[Peak], midSideChannel);
+    chain.highCutBypassed = chain.highCutBypassed || !doesBandReach(chain.bandChannels[HighCut], midSideChannel);
+
+    return chain;
+}
+
+ParallelCoefficients makeParallelCoefficients(const ChainCoefficients &chainCoefficients, double sampleRate)
+{
+    using Complex = std::complex<double>;
+
+    ParallelCoefficients parallel;
+
+    // * the active biquads in processing order and where each one sits in ParallelCoefficients::sections
+    std::array<BiquadCoeffs, MaxChainSections> cascade;
+    std::array<size_t, MaxChainSections> indices{};
+    size_t numSections = 0;
+
+    forEachActiveSection(chainCoefficients, [&](const BiquadCoeffs &coefficients, int position)
+                         {
+                             cascade[numSections] = coefficients;
+                             indices[numSections++] = (size_t)position;
+                         });
+
+    // * the poles are known section by section, no polynomial is ever expanded or rooted
+    std::array<std::array<Complex, 2>, MaxChainSections> poles;
+
+    for (size_t k = 0; k < numSections; ++k)
     {
-        lowCut.template get<3>().coefficients = cutCoefficients[3];
-        lowCut.template setBypassed<3>(false);
+        const auto root = std::sqrt(Complex(cascade[k].a1 * cascade[k].a1 - 4.0 * cascade[k].a2));
+        poles[k] = {(-cascade[k].a1 + root) * 0.5, (-cascade[k].a1 - root) * 0.5};
     }
-    case Slope_36:
+
+    // * in positive powers of z, H(z) = direct + sum of R / (z - p), direct is H at infinity
+    for (size_t k = 0; k < numSections; ++k)
+        parallel.direct *= cascade[k].b0;
+
+    for (size_t k = 0; k < numSections; ++k)
     {
-        lowCut.template get<2>().coefficients = cutCoefficients[2];
-        lowCut.template setBypassed<2>(false);
+        std::array<Complex, 2> residues;
+
+        for (size_t i = 0; i < 2; ++i)
+        {
+            const auto p = poles[k][i];
+            Complex numerator{1.0}, denominator{p - poles[k][1 - i]};
+
+            for (size_t j = 0; j < numSections; ++j)
+            {
+                numerator *= (cascade[j].b0 * p + cascade[j].b1) * p + cascade[j].b2;
+
+                if (j != k)
+                    denominator *= (p + cascade[j].a1) * p + cascade[j].a2;
+            }
+
+            residues[i] = numerator / denominator;
+        }
+
+        // * R0 / (z - p0) + R1 / (z - p1) over the section's own denominator, real for a conjugate or a real pair
+        parallel.sections[indices[k]] = {(residues[0] + residues[1]).real(),
+                                         -(residues[0] * poles[k][1] + residues[1] * poles[k][0]).real(),
+                                         cascade[k].a1,
+                                         cascade[k].a2};
     }
-    case Slope_24:
+
+    // * poles close together give huge residues that cancel, check the sum against the cascade
+    static constexpr int numPoints = 64;
+    const auto lowest = 10.0;
+    const auto highest = sampleRate * 0.5 * 0.999;
+
+    for (int n = 0; n < numPoints; ++n)
     {
-        lowCut.template get<1>().coefficients = cutCoefficients[1];
-        lowCut.template setBypassed<1>(false);
+        const auto frequency = lowest * std::pow(highest / lowest, (double)n / (double)(numPoints - 1));
+        const auto z1 = std::polar(1.0, -juce::MathConstants<double>::twoPi * frequency / sampleRate);
+
+        Complex cascadeResponse{1.0}, parallelResponse{parallel.direct};
+
+        for (size_t k = 0; k < numSections; ++k)
+        {
+            const auto &section = parallel.sections[indices[k]];
+
+            cascadeResponse *= getResponseForFrequency(cascade[k], frequency, sampleRate);
+            parallelResponse += z1 * (section.b1 + z1 * section.b2) / (1.0 + z1 * (section.a1 + z1 * section.a2));
+        }
+
+        const auto difference = std::abs(parallelResponse - cascadeResponse) / juce::jmax(std::abs(cascadeResponse), 1.0e-3);
+
+        // * a repeated pole divides by 0
+        if (!std::isfinite(difference))
+            return {1.0, {}, std::numeric_limits<double>::infinity()};
+
+        parallel.error = juce::jmax(parallel.error, difference);
     }
-    case Slope_12:
+
+    return parallel;
+}
+
+bool isEffectivelyIdentity(const BiquadCoeffs &coefficients, double sampleRate)
+{
+    // * exact pole/zero cancellation, what a peak at 0 dB designs to
+    if (coefficients.b0 == 1.0 && coefficients.b1 == coefficients.a1 && coefficients.b2 == coefficients.a2)
+        return true;
+
+    // * otherwise compare with a wire on a log grid from 20 Hz to 20 kHz (or Nyquist)
+    static constexpr int numPoints = 64;
+    static constexpr double maxError = 1.0e-3;
+
+    const auto lowest = 20.0;
+    const auto highest = juce::jmin(20000.0, sampleRate * 0.5);
+
+    for (int i = 0; i < numPoints; ++i)
     {
-        lowCut.template get<0>().coefficients = cutCoefficients[0];
-        lowCut.template setBypassed<0>(false);
+        auto frequency = lowest * std::pow(highest / lowest, i / (numPoints - 1.0));
+
+        if (std::abs(getResponseForFrequency(coefficients, frequency, sampleRate) - 1.0) > maxError)
+            return false;
     }
+
+    return true;
+}
+
+double getPoleRadius(const BiquadCoeffs &coefficients)
+{
+    // * poles are the roots of z^2 + a1 z + a2
+    const auto discriminant = coefficients.a1 * coefficients.a1 - 4.0 * coefficients.a2;
+
+    // * complex pair: both have magnitude sqrt(a2)
+    if (discriminant < 0)
+        return std::sqrt(coefficients.a2);
+
+    const auto root = std::sqrt(discriminant);
+
+    return juce::jmax(std::abs(-coefficients.a1 + root), std::abs(-coefficients.a1 - root)) * 0.5;
+}
+
+double getTailLengthSeconds(const ChainCoefficients &chainCoefficients, double sampleRate)
+{
+    // * the FIR output is silent one kernel length after its input
+    if (chainCoefficients.processingMode == ProcessingMode::LinearPhase)
+        return getLinearPhaseKernelLength(sampleRate) / sampleRate;
+
+    // * a pole of radius r decays as r^n, each section rings on after the one before it has gone quiet
+    auto getSectionTail = [](const BiquadCoeffs &coefficients)
+    {
+        const auto radius = getPoleRadius(coefficients);
+
+        if (radius <= 0)
+            return 2.0;
+
+        // * unstable or on the unit circle, never rings out
+        if (radius >= 1)
+            return std::numeric_limits<double>::infinity();
+
+        return std::log(SilenceThreshold) / std::log(radius);
+    };
+
+    double tailSamples = 0;
+
+    forEachActiveSection(chainCoefficients, [&](const BiquadCoeffs &coefficients, int)
+                         { tailSamples += getSectionTail(coefficients); });
+
+    return tailSamples / sampleRate;
+}
+
+int getLinearPhaseKernelLength(double sampleRate)
+{
+    // * ~170ms worth of taps: 8192 at 44.1/48kHz, up to 32768 at 176.4/192kHz
+    return juce::nextPowerOfTwo(juce::roundToInt(sampleRate * 0.17));
+}
+
+juce::AudioBuffer<float> makeLinearPhaseKernel(const ChainCoefficients &chainCoefficients, double sampleRate, int numKernels)
+{
+    const auto length = getLinearPhaseKernelLength(sampleRate);
+
+    juce::dsp::FFT fft(juce::roundToInt(std::log2(length)));
+    std::vector<float> data((size_t)length * 2);
+
+    juce::AudioBuffer<float> kernel(numKernels, length);
+
+    for (int channel = 0; channel < numKernels; ++channel)
+    {
+        if (channel > 0 && !chainCoefficients.midSide)
+        {
+            kernel.copyFrom(channel, 0, kernel, 0, 0, length);
+            continue;
+        }
+
+        const auto chain = chainCoefficients.midSide ? getMidSideChain(chainCoefficients, channel) : chainCoefficients;
+
+        std::fill(data.begin(), data.end(), 0.f);
+
+        // * zero phase spectrum delayed by length / 2 samples, e^(-j*pi*k) just flips every other bin
+        for (int k = 0; k <= length / 2; ++k)
+        {
+            auto mag = (float)getMagnitudeForFrequency(chain, k * sampleRate / length, sampleRate);
+            data[(size_t)(2 * k)] = (k % 2 == 0) ? mag : -mag;
+        }
+
+        fft.performRealOnlyInverseTransform(data.data());
+
+        // * periodic Blackman window, symmetric around the centre tap so the phase stays linear
+        auto *taps = kernel.getWritePointer(channel);
+
+        for (int n = 0; n < length; ++n)
+        {
+            auto phase = juce::MathConstants<double>::twoPi * n / length;
+            auto window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2.0 * phase);
+
+            taps[n] = (float)(data[(size_t)n] * window);
+        }
     }
+
+    return kernel;
 }
+
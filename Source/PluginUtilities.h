@@ -12,32 +12,129 @@
 
 #include <JuceHeader.h>
 
-using Filter = juce::dsp::IIR::Filter<float>;
+// * one biquad per 12 dB/Oct, up to 96 dB/Oct
+static constexpr int MaxCutSections = 8;
 
-using CutFilter = juce::dsp::ProcessorChain<Filter, Filter, Filter, Filter>;
-
-// * chain will process single audio to all defined processors
-using MonoChain = juce::dsp::ProcessorChain<CutFilter, Filter, CutFilter>;
+// * the bank of parametric bands between the cuts, inactive bands aren't processed
+static constexpr int MaxPeakBands = 16;
 
 enum Slope
 {
     Slope_12,
     Slope_24,
     Slope_36,
-    Slope_48
+    Slope_48,
+    Slope_60,
+    Slope_72,
+    Slope_84,
+    Slope_96
+};
+
+static_assert(Slope_96 + 1 == MaxCutSections, "one cut section per slope step");
+
+// * minimum phase runs the biquads, linear phase runs an FIR with the same magnitude response
+enum ProcessingMode
+{
+    MinimumPhase,
+    LinearPhase
+};
+
+// * the minimum phase chain can run at 2x or 4x the host rate
+enum OversamplingFactor
+{
+    Oversampling_Off,
+    Oversampling_2x,
+    Oversampling_4x
+};
+
+static constexpr int NumOversamplingFactors = 3;
+
+// * how the minimum phase bands are built: transposed direct form II biquads, TPT state variable filters
+// * or the whole chain as parallel second order sections
+enum FilterStructure
+{
+    FilterStructure_Biquad,
+    FilterStructure_StateVariable,
+    FilterStructure_Parallel
+};
+
+// * how the peak band is designed: bilinear transform (cramps near Nyquist) or matched to the analog magnitude
+enum PeakDesign
+{
+    PeakDesign_Bilinear,
+    PeakDesign_Matched
+};
+
+// * left/right filters both channels alike, mid/side filters (L + R) / 2 and (L - R) / 2 of a stereo pair
+enum StereoMode
+{
+    StereoMode_LeftRight,
+    StereoMode_MidSide
+};
+
+// * which signal of the mid/side pair a band filters, both in left/right
+enum BandChannels
+{
+    BandChannels_Both,
+    BandChannels_Mid,
+    BandChannels_Side
+};
+
+// * channel 0 of the pair is mid, 1 is side
+constexpr bool doesBandReach(BandChannels bandChannels, int midSideChannel) noexcept
+{
+    return bandChannels == BandChannels_Both || (int)bandChannels == BandChannels_Mid + midSideChannel;
+}
+
+// * the shape of a band of the bank, the notch ignores the gain
+enum PeakBandType
+{
+    PeakBandType_Peak,
+    PeakBandType_LowShelf,
+    PeakBandType_HighShelf,
+    PeakBandType_Notch
+};
+
+// * which band frequencies the internal LFO sweeps
+enum ModulationTarget
+{
+    ModulationTarget_Peak,
+    ModulationTarget_LowCut,
+    ModulationTarget_HighCut,
+    ModulationTarget_AllBands
+};
+
+// * one band of the bank
+struct PeakBandSettings
+{
+    float freq{750.f}, gainInDecibels{0}, quality{1.f};
+    PeakBandType type{PeakBandType::PeakBandType_Peak};
+    bool bypassed{false};
 };
 
 // * structure to hold our parameters
 struct ChainSettings
 {
-    float peakFreq{0}, peakGainInDecibels{0}, peakQuality{1.f};
+    // * band 0 is the one the editor shows and the LFO sweeps
+    std::array<PeakBandSettings, MaxPeakBands> peakBands;
     float lowCutFreq{0}, highCutFreq{0};
     Slope lowCutSlope{Slope::Slope_12}, highCutSlope{Slope::Slope_12};
 
-    bool lowCutBypassed{false}, peakBypassed{false}, highCutBypassed{false};
-};
+    bool lowCutBypassed{false}, highCutBypassed{false};
+
+    ProcessingMode processingMode{ProcessingMode::MinimumPhase};
+    OversamplingFactor oversampling{OversamplingFactor::Oversampling_Off};
+    FilterStructure filterStructure{FilterStructure::FilterStructure_Biquad};
+    PeakDesign peakDesign{PeakDesign::PeakDesign_Bilinear};
 
-ChainSettings getChainSettings(juce::AudioProcessorValueTreeState &apvts);
+    // * depth is how far the LFO moves the frequency knobs each way, 0 to 1 of their travel
+    ModulationTarget modulationTarget{ModulationTarget::ModulationTarget_Peak};
+    float modulationRate{1.f}, modulationDepth{0.f};
+
+    // * indexed by ChainPositions, Peak places the whole bank
+    StereoMode stereoMode{StereoMode::StereoMode_LeftRight};
+    std::array<BandChannels, 3> bandChannels{};
+};
 
 enum ChainPositions
 {
@@ -46,21 +143,261 @@ enum ChainPositions
     HighCut
 };
 
-using Coefficients = Filter::CoefficientsPtr;
+// * plain biquad coefficients, normalised so that a0 == 1
+// * always designed in double, a float chain rounds them once when they are loaded
+struct BiquadCoeffs
+{
+    double b0{1.0}, b1{0.0}, b2{0.0}, a1{0.0}, a2{0.0};
+};
+
+// * std::cos() isn't constexpr before C++20, a Taylor series is plenty for 0 <= x <= pi / 2
+constexpr double constexprCos(double x) noexcept
+{
+    double term = 1.0, sum = 1.0;
+
+    for (int n = 1; n < 16; ++n)
+    {
+        term *= -x * x / ((2 * n - 1) * (2 * n));
+        sum += term;
+    }
+
+    return sum;
+}
+
+// * Qs of a Butterworth made of numSections biquads (order 2 * numSections) are at [numSections - 1]
+// * Q_i = 1 / (2 cos((2i + 1) pi / (2 * order))), same as FilterDesign, worked out at compile time
+template <size_t MaxSections>
+constexpr std::array<std::array<double, MaxSections>, MaxSections> makeButterworthQs() noexcept
+{
+    std::array<std::array<double, MaxSections>, MaxSections> qs{};
+
+    for (size_t numSections = 1; numSections <= MaxSections; ++numSections)
+        for (size_t i = 0; i < numSections; ++i)
+            qs[numSections - 1][i] = 1.0 / (2.0 * constexprCos(juce::MathConstants<double>::pi * (double)(2 * i + 1) / (double)(4 * numSections)));
+
+    return qs;
+}
+
+// * bilinear second order sections, the same maths as IIR::Coefficients::makeHighPass()/makeLowPass()
+// * n is the prewarped cutoff: tan(pi * f / sr) for the high pass, 1 / tan(pi * f / sr) for the low pass
+constexpr BiquadCoeffs makeHighPassSection(double n, double q) noexcept
+{
+    const auto n2 = n * n;
+    const auto c1 = 1.0 / (1.0 + n / q + n2);
+
+    return {c1, -2.0 * c1, c1, c1 * 2.0 * (n2 - 1.0), c1 * (1.0 - n / q + n2)};
+}
+
+constexpr BiquadCoeffs makeLowPassSection(double n, double q) noexcept
+{
+    const auto n2 = n * n;
+    const auto c1 = 1.0 / (1.0 + n / q + n2);
+
+    return {c1, 2.0 * c1, c1, c1 * 2.0 * (1.0 - n2), c1 * (1.0 - n / q + n2)};
+}
+
+// * Butterworth cascades of numSections biquads written straight into a fixed array, no heap and no reference counting
+// * the sections past numSections are left as identity
+template <size_t MaxSections>
+std::array<BiquadCoeffs, MaxSections> designButterworthHighPass(double frequency, double sampleRate, int numSections) noexcept
+{
+    static constexpr auto qs = makeButterworthQs<MaxSections>();
+    jassert(numSections >= 1 && numSections <= (int)MaxSections);
+
+    std::array<BiquadCoeffs, MaxSections> sections;
+    const auto n = std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+
+    for (size_t i = 0; i < (size_t)numSections; ++i)
+        sections[i] = makeHighPassSection(n, qs[(size_t)numSections - 1][i]);
+
+    return sections;
+}
+
+template <size_t MaxSections>
+std::array<BiquadCoeffs, MaxSections> designButterworthLowPass(double frequency, double sampleRate, int numSections) noexcept
+{
+    static constexpr auto qs = makeButterworthQs<MaxSections>();
+    jassert(numSections >= 1 && numSections <= (int)MaxSections);
+
+    std::array<BiquadCoeffs, MaxSections> sections;
+    const auto n = 1.0 / std::tan(juce::MathConstants<double>::pi * frequency / sampleRate);
+
+    for (size_t i = 0; i < (size_t)numSections; ++i)
+        sections[i] = makeLowPassSection(n, qs[(size_t)numSections - 1][i]);
+
+    return sections;
+}
+
+// * one band of the bank, a peak, a shelf or a notch
+BiquadCoeffs makePeakFilter(const PeakBandSettings &band, double sampleRate);
+// * the same peak matched to the analog one up to Nyquist, see PeakDesign
+BiquadCoeffs makeMatchedPeakFilter(const PeakBandSettings &band, double sampleRate);
+
+// * one section per 12 dB/Oct, sections beyond the slope are left as identity
+std::array<BiquadCoeffs, MaxCutSections> makeLowCutFilter(const ChainSettings &chainSettings, double sampleRate);
+std::array<BiquadCoeffs, MaxCutSections> makeHighCutFilter(const ChainSettings &chainSettings, double sampleRate);
+
+// * one TPT state variable filter section, the same response as the matching biquad
+// * g = tan(pi f / sr) and k = 1 / Q set the filter, the output is m0 * input + m1 * band + m2 * low
+// * any g > 0 and k > 0 is stable, so the parameters can jump or be swept every sample
+struct SvfParameters
+{
+    double g{0.1}, k{2.0}, m0{1.0}, m1{0.0}, m2{0.0};
+};
+
+constexpr SvfParameters makeSvfHighPass(double g, double q) noexcept { return {g, 1.0 / q, 1.0, -1.0 / q, -1.0}; }
+constexpr SvfParameters makeSvfLowPass(double g, double q) noexcept { return {g, 1.0 / q, 0.0, 0.0, 1.0}; }
+
+// * gain is the square root of the linear gain, like makePeakFilter()
+constexpr SvfParameters makeSvfPeak(double g, double q, double gain) noexcept
+{
+    const auto k = 1.0 / (q * gain);
+    return {g, k, 1.0, k * (gain * gain - 1.0), 0.0};
+}
+
+// * any stable biquad as a state variable filter with the same response: undo the bilinear transform
+// * with the g that makes the analog denominator s^2 + k s + 1, the numerator gives the mix
+inline SvfParameters makeSvfFromBiquad(const BiquadCoeffs &coefficients) noexcept
+{
+    // * |1 - p|^2 and |1 + p|^2 of the poles, both positive when they are inside the unit circle
+    const auto atDC = 1.0 + coefficients.a1 + coefficients.a2;
+    const auto atNyquist = 1.0 - coefficients.a1 + coefficients.a2;
+    jassert(atDC > 0 && atNyquist > 0);
+
+    const auto g = std::sqrt(atDC / atNyquist);
+    const auto k = 2.0 * g * (1.0 - coefficients.a2) / atDC;
+
+    const auto n2 = g * g * (coefficients.b0 - coefficients.b1 + coefficients.b2) / atDC;
+    const auto n1 = 2.0 * g * (coefficients.b0 - coefficients.b2) / atDC;
+    const auto n0 = (coefficients.b0 + coefficients.b1 + coefficients.b2) / atDC;
+
+    return {g, k, n2, n1 - n2 * k, n0 - n2};
+}
+
+// * one biquad per cut stage and per band of the bank, the most sections the chain can have
+static constexpr int MaxChainSections = 2 * MaxCutSections + MaxPeakBands;
+
+// * a section of the parallel form, the numerator has no b0: b1 z^-1 + b2 z^-2
+struct ParallelSection
+{
+    double b1{0}, b2{0}, a1{0}, a2{0};
+};
+
+// * the chain as direct * x + the sum of the sections, a partial fraction expansion of the cascade
+// * each section keeps the poles of one cascade biquad and is indexed like it, LowCut stages, peak
+// * bands, HighCut stages, sections of biquads that are switched off are 0
+struct ParallelCoefficients
+{
+    double direct{1};
+    std::array<ParallelSection, MaxChainSections> sections{};
+
+    // * largest difference to the cascade response, relative to it with a -60 dB floor
+    double error{0};
+};
+
+// * audio rate LFO on the band frequencies, run by MultiChannelSvfChain from a FrequencyTable
+// * positions and depths are normalised frequency knob values, indexed by ChainPositions
+// * a band isn't modulated when its depth is 0, Peak is the first band of the bank
+struct FrequencyModulation
+{
+    double rate{0};
+    std::array<double, 3> positions{}, depths{};
+
+    bool isActive() const noexcept { return depths[LowCut] > 0 || depths[Peak] > 0 || depths[HighCut] > 0; }
+};
+
+// * everything needed to set up a chain, designed once per parameter change
+// * it is a plain value so it can be copied between threads without allocating
+// * the bank is stored as arrays of a fixed capacity, a band that is switched off or flat is bypassed
+struct ChainCoefficients
+{
+    std::array<BiquadCoeffs, MaxPeakBands> peaks;
+    std::array<BiquadCoeffs, MaxCutSections> lowCut, highCut;
+    Slope lowCutSlope{Slope::Slope_12}, highCutSlope{Slope::Slope_12};
+
+    bool lowCutBypassed{false}, highCutBypassed{false};
+    std::array<bool, MaxPeakBands> peakBypassed{};
 
-// * we need to be free function because we will use it in the Editor.h
-void updateCoefficients(Coefficients &old, const Coefficients &replacements);
+    ProcessingMode processingMode{ProcessingMode::MinimumPhase};
+    OversamplingFactor oversampling{OversamplingFactor::Oversampling_Off};
 
-// * we need to be free function because we will use it in the Editor.h
-Coefficients makePeakFilter(const ChainSettings &chainSettings, double sampleRate);
+    // * how long the output rings after the input goes silent, see getTailLengthSeconds()
+    double tailSeconds{0};
 
-juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> makeLowCutFilter(const ChainSettings &chainSettings, double sampleRate);
-juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> makeHighCutFilter(const ChainSettings &chainSettings, double sampleRate);
+    FrequencyModulation modulation;
 
-// * we need to be free function because we will use it in the Editor.h
-void updateCutFilter(CutFilter &lowCut,
-                     const juce::ReferenceCountedArray<juce::dsp::IIR::Coefficients<float>> &cutCoefficients,
-                     const Slope &slope);
+    // * the structure the user picked, and the one that runs: the parallel form hands what it can't run to the biquads
+    FilterStructure filterStructure{FilterStructure::FilterStructure_Biquad};
+    FilterStructure effectiveStructure{FilterStructure::FilterStructure_Biquad};
+
+    // * the same bands for the state variable structure, sections past the slope pass the input through
+    std::array<SvfParameters, MaxPeakBands> peakSvf;
+    std::array<SvfParameters, MaxCutSections> lowCutSvf, highCutSvf;
+
+    // * the same chain for the parallel structure
+    ParallelCoefficients parallel;
+
+    // * the Mid/Side stereo mode, only for a stereo pair: the bands filter the lanes bandChannels puts them on
+    // * with every band on both it sounds like left/right, so the stereo pair is always matrixed and only the
+    // * placement changes, bandChannels is indexed by ChainPositions
+    bool midSide{false};
+    std::array<BandChannels, 3> bandChannels{};
+};
+
+// * where a section sits in the chain, in processing order: LowCut stages, peak bands, HighCut stages
+static constexpr int LowCutPosition = 0;
+static constexpr int PeakPosition = LowCutPosition + MaxCutSections;
+static constexpr int HighCutPosition = PeakPosition + MaxPeakBands;
+
+static_assert(HighCutPosition + MaxCutSections == MaxChainSections, "every section has a position");
+
+// * calls function(coefficients, position) for the sections that are switched on, in processing order
+template <typename Function>
+void forEachActiveSection(const ChainCoefficients &chainCoefficients, Function &&function)
+{
+    if (!chainCoefficients.lowCutBypassed)
+        for (int i = 0; i <= chainCoefficients.lowCutSlope; ++i)
+            function(chainCoefficients.lowCut[(size_t)i], LowCutPosition + i);
+
+    for (int band = 0; band < MaxPeakBands; ++band)
+        if (!chainCoefficients.peakBypassed[(size_t)band])
+            function(chainCoefficients.peaks[(size_t)band], PeakPosition + band);
+
+    if (!chainCoefficients.highCutBypassed)
+        for (int i = 0; i <= chainCoefficients.highCutSlope; ++i)
+            function(chainCoefficients.highCut[(size_t)i], HighCutPosition + i);
+}
+
+// * does all the filter design math, doesn't allocate but calls into libm, keep it away from the audio thread
+ChainCoefficients makeChainCoefficients(const ChainSettings &chainSettings, double sampleRate);
+
+// * partial fractions of the active sections of a designed chain, also on the designer thread
+ParallelCoefficients makeParallelCoefficients(const ChainCoefficients &chainCoefficients, double sampleRate);
+
+std::complex<double> getResponseForFrequency(const BiquadCoeffs &coefficients, double frequency, double sampleRate);
+double getMagnitudeForFrequency(const BiquadCoeffs &coefficients, double frequency, double sampleRate);
+// * magnitude of the whole chain, only the sections that are switched on, the Editor draws it
+double getMagnitudeForFrequency(const ChainCoefficients &chainCoefficients, double frequency, double sampleRate);
+
+// * the chain one signal of the mid/side pair goes through, the bands placed on the other one are bypassed
+ChainCoefficients getMidSideChain(const ChainCoefficients &chainCoefficients, int midSideChannel);
+
+// * -120 dB, input below it counts as silence and tails are measured until they fall below it
+static constexpr double SilenceThreshold = 1.0e-6;
+
+// * the section changes the audible band by less than -60 dB, in magnitude and in phase
+bool isEffectivelyIdentity(const BiquadCoeffs &coefficients, double sampleRate);
+
+// * the largest pole magnitude of the section, it sets how fast the section rings out
+double getPoleRadius(const BiquadCoeffs &coefficients);
+// * time for the impulse response of the active sections to decay below SilenceThreshold
+double getTailLengthSeconds(const ChainCoefficients &chainCoefficients, double sampleRate);
+
+// * the FIR used in linear phase mode, its latency is half its length
+int getLinearPhaseKernelLength(double sampleRate);
+// * designs the FIR from the chain magnitude response, allocates, keep it away from the audio thread
+// * numKernels is 1, or 2 for mid and side, the same kernel twice when no band is placed on one of them
+juce::AudioBuffer<float> makeLinearPhaseKernel(const ChainCoefficients &chainCoefficients, double sampleRate, int numKernels);
 
 enum Channel
 {
@@ -132,6 +469,54 @@ private:
     juce::AbstractFifo fifo{Capacity};
 };
 
+// * lock-free hand over of the newest value from one writer to one reader (triple buffer)
+// * the writer never waits for the reader and the reader always gets the latest complete value
+template <typename T>
+struct LatestValueExchange
+{
+    static_assert(std::is_trivially_copyable_v<T>, "LatestValueExchange copies values, keep them plain");
+
+    // * writer side
+    void push(const T &t)
+    {
+        buffers[writeIndex] = t;
+        writeIndex = middle.exchange(writeIndex | NewDataFlag, std::memory_order_acq_rel) & IndexMask;
+    }
+
+    // * reader side, returns false if nothing new was pushed since the last pull
+    bool pull(T &t)
+    {
+        if ((middle.load(std::memory_order_acquire) & NewDataFlag) == 0)
+            return false;
+
+        readIndex = middle.exchange(readIndex, std::memory_order_acq_rel) & IndexMask;
+        t = buffers[readIndex];
+        return true;
+    }
+
+private:
+    static constexpr int NewDataFlag = 4;
+    static constexpr int IndexMask = 3;
+
+    std::array<T, 3> buffers;
+    int writeIndex = 0, readIndex = 1;
+    std::atomic<int> middle{2};
+};
+
+// * one background thread shared by every plugin instance in the process, used to design coefficients
+struct CoefficientDesignThread : juce::TimeSliceThread
+{
+    CoefficientDesignThread() : juce::TimeSliceThread("Coefficient Designer")
+    {
+        startThread();
+    }
+
+    ~CoefficientDesignThread() override
+    {
+        stopThread(1000);
+    }
+};
+
 template <typename BlockType>
 struct SingleChannelSampleFifo
 {
@@ -143,8 +528,9 @@ struct SingleChannelSampleFifo
     void update(const BlockType &buffer)
     {
         jassert(prepared.get());
-        jassert(buffer.getNumChannels() > channelToUse);
-        auto *channelPtr = buffer.getReadPointer(channelToUse);
+        jassert(buffer.getNumChannels() > 0);
+        // * a mono bus shows the same channel on both sides
+        auto *channelPtr = buffer.getReadPointer(juce::jmin((int)channelToUse, buffer.getNumChannels() - 1));
 
         for (int i = 0; i < buffer.getNumSamples(); ++i)
         {
@@ -0,0 +1,163 @@
+/*
+  ==============================================================================
+
+    SvfEngine.h
+    Created: 16 Oct 2026 9:03:52pm
+    Author:  brccabral
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include "PluginUtilities.h"
+#include "FrequencyTable.h"
+#include "ChainEngine.h"
+
+inline SvfParameters interpolate(const SvfParameters &a, const SvfParameters &b, double t) noexcept
+{
+    return {interpolate(a.g, b.g, t), interpolate(a.k, b.k, t), interpolate(a.m0, b.m0, t), interpolate(a.m1, b.m1, t), interpolate(a.m2, b.m2, t)};
+}
+
+// * the output mix between a pass through, weight 0, and the filter, weight 1, the loop isn't touched
+inline SvfParameters fadeFromPassThrough(const SvfParameters &parameters, double weight) noexcept
+{
+    if (weight == 1.0)
+        return parameters;
+
+    return {parameters.g, parameters.k, 1.0 + weight * (parameters.m0 - 1.0), weight * parameters.m1, weight * parameters.m2};
+}
+
+// * one state variable filter per lane, a1, a2, a3 are the loop coefficients worked out from g and k
+template <typename SampleType>
+struct SvfLanes
+{
+    using Vec = juce::dsp::SIMDRegister<SampleType>;
+
+    Vec a1, a2, a3, m0, m1, m2;
+};
+
+/*
+ The LowCut -> peak bank -> HighCut chain built from topology preserving transform state variable
+ filters (trapezoidal integrators, as in Zavalishin's and Simper's papers) instead of biquads.
+ Same slots, same SIMD lanes per channel and the same interface as MultiChannelChain, both are
+ built on LaneChainEngine, and the same magnitude response, both are bilinear transforms of one
+ analog prototype.
+
+ The filter is set by g = tan(pi f / sr) and k = 1 / Q, the coefficients the loop uses are one
+ division away from them. The state holds the integrator values, not a mix of past inputs and
+ outputs, so it stays meaningful when the parameters change: jumps don't blow up and a sweep
+ only needs a new g per sample, no redesign.
+ Parameter changes glide linearly in (g, k, m0, m1, m2) every controlInterval samples, every
+ point on the way has g > 0 and k > 0 and is stable. Sections switching on or off fade their
+ output mix from or to a pass through.
+ A stereo pair runs as mid and side, a band fades its output mix to a pass through on the lane it
+ doesn't reach, the loop runs on both, so a sweep still only needs the new g.
+ */
+template <typename SampleType>
+class MultiChannelSvfChain : public LaneChainEngine<MultiChannelSvfChain<SampleType>, SampleType, SvfLanes<SampleType>, SvfParameters>
+{
+    using Base = LaneChainEngine<MultiChannelSvfChain<SampleType>, SampleType, SvfLanes<SampleType>, SvfParameters>;
+    friend Base;
+
+    using typename Base::Vec;
+    using Base::Lanes;
+    using Section = SvfLanes<SampleType>;
+
+    static constexpr bool FollowsLfo = true;
+
+    // * the band of each packed section that follows the LFO, -1 for the rest
+    std::array<int, NumChainSlots> modulatedBands{};
+    std::array<double, NumChainSlots> packedK{};
+
+    void setSlotTargets(const ChainCoefficients &chainCoefficients) noexcept
+    {
+        auto &targets = this->targetParameters;
+
+        for (int i = 0; i < MaxCutSections; ++i)
+        {
+            targets[(size_t)(LowCutSlot + i)] = chainCoefficients.lowCutSvf[(size_t)i];
+            targets[(size_t)(HighCutSlot + i)] = chainCoefficients.highCutSvf[(size_t)i];
+        }
+
+        for (int band = 0; band < MaxPeakBands; ++band)
+            targets[(size_t)(PeakSlot + band)] = chainCoefficients.peakSvf[(size_t)band];
+    }
+
+    void setSection(int n, const SvfParameters &parameters, double weight, int band, int modulatedBand) noexcept
+    {
+        modulatedBands[(size_t)n] = modulatedBand;
+        packedK[(size_t)n] = parameters.k;
+
+        auto &section = this->sections[(size_t)n];
+        setLoopCoefficients(section, parameters.g, parameters.k);
+        setOutputMix(section, fadeFromPassThrough(parameters, weight), band);
+    }
+
+    // * in mid/side faded to a pass through by how much the band reaches the lane
+    void setOutputMix(Section &section, const SvfParameters &parameters, int band) const noexcept
+    {
+        if (!this->midSide)
+        {
+            section.m0 = Vec::expand((SampleType)parameters.m0);
+            section.m1 = Vec::expand((SampleType)parameters.m1);
+            section.m2 = Vec::expand((SampleType)parameters.m2);
+            return;
+        }
+
+        alignas(Vec) SampleType m0[Lanes], m1[Lanes], m2[Lanes];
+
+        for (size_t l = 0; l < (size_t)Lanes; ++l)
+        {
+            const auto mix = fadeFromPassThrough(parameters, this->getLaneWeight(band, l));
+
+            m0[l] = (SampleType)mix.m0;
+            m1[l] = (SampleType)mix.m1;
+            m2[l] = (SampleType)mix.m2;
+        }
+
+        section.m0 = Vec::fromRawArray(m0);
+        section.m1 = Vec::fromRawArray(m1);
+        section.m2 = Vec::fromRawArray(m2);
+    }
+
+    static void setLoopCoefficients(Section &section, double g, double k) noexcept
+    {
+        const auto a1 = 1.0 / (1.0 + g * (g + k));
+        const auto a2 = g * a1;
+
+        section.a1 = Vec::expand((SampleType)a1);
+        section.a2 = Vec::expand((SampleType)a2);
+        section.a3 = Vec::expand((SampleType)(g * a2));
+    }
+
+    // * only g follows the LFO, k and the output mix stay, that is the whole redesign
+    template <size_t Capacity>
+    void modulateSections(std::array<Section, Capacity> &c, size_t numSections, double lfoValue) const noexcept
+    {
+        const auto &modulation = this->currentChain.modulation;
+        std::array<double, 3> gs{};
+
+        for (size_t band = 0; band < 3; ++band)
+            if (modulation.depths[band] > 0)
+                gs[band] = this->frequencyTable->lookup(modulation.positions[band] + modulation.depths[band] * lfoValue).tanHalfOmega;
+
+        for (size_t n = 0; n < numSections; ++n)
+            if (modulatedBands[n] >= 0)
+                setLoopCoefficients(c[n], gs[(size_t)modulatedBands[n]], packedK[n]);
+    }
+
+    // * s1 and s2 are the two integrator states, ic1eq and ic2eq in Simper's paper
+    static Vec processSection(const Section &c, Vec &s1, Vec &s2, Vec x) noexcept
+    {
+        auto v3 = x - s2;
+        auto v1 = c.a1 * s1 + c.a2 * v3;
+        auto v2 = s2 + c.a2 * s1 + c.a3 * v3;
+
+        s1 = v1 + v1 - s1;
+        s2 = v2 + v2 - s2;
+
+        return c.m0 * x + c.m1 * v1 + c.m2 * v2;
+    }
+};